@@ -0,0 +1,84 @@
+/***************************************************************************//**
+ * @filename BM_ConcurrentFreeListAllocator.cpp
+ * @brief	 Contains the thread safe free list allocator benchmark function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "Benchmarks.h"
+#include "FreeListAllocator.h"
+#include "ConcurrentFreeListAllocator.h"
+
+namespace BM
+{
+	namespace Allocator
+	{
+		constexpr unsigned LIVE_CHUNKS_PER_THREAD = 256u;
+		constexpr unsigned OPERATIONS_PER_THREAD = 200000u;
+
+		// Runs the same random free & allocate sequence on every thread, returns millions of operations (allocate + free) per second
+		template <typename AllocateFn, typename FreeFn>
+		static double RunThreads(const unsigned& thread_count, AllocateFn&& allocate, FreeFn&& free)
+		{
+			std::vector<std::thread> threads;
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned t = 0u; t < thread_count; t++)
+			{
+				threads.emplace_back([&allocate, &free, t]()
+					{
+						std::mt19937 rng(42u + t);
+						std::vector<void*> chunks(LIVE_CHUNKS_PER_THREAD, nullptr);
+
+						for (unsigned i = 0u; i < OPERATIONS_PER_THREAD; i++)
+						{
+							void*& chunk = chunks[rng() % LIVE_CHUNKS_PER_THREAD];
+							if (chunk != nullptr)
+								free(chunk);
+
+							// Mostly small chunks with the odd large one
+							chunk = allocate(rng() % 32u == 0u ? 512u + rng() % 1024u : 12u + rng() % 116u);
+						}
+
+						for (void* chunk : chunks)
+							if (chunk != nullptr)
+								free(chunk);
+					});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			return static_cast<double>(thread_count) * OPERATIONS_PER_THREAD / ElapsedMs(start) / 1000.0;
+		}
+
+		void concurrentfreelist_scaling()
+		{
+			const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+			std::vector<std::byte> buffer(1u << 26);
+
+			for (unsigned thread_count = 1u; thread_count <= max_threads; thread_count *= 2u)
+			{
+				// A single free list behind a global mutex, what we had before
+				FreeListAllocator fla(FreeListAllocator::e_AllocType::e_bestfit);
+				fla.Init(buffer);
+				std::mutex fla_mutex;
+
+				const double locked_mops = RunThreads(thread_count,
+					[&fla, &fla_mutex](const unsigned& size_in_bytes) { std::lock_guard<std::mutex> lock(fla_mutex); return fla.Allocate(size_in_bytes); },
+					[&fla, &fla_mutex](void* ptr) { std::lock_guard<std::mutex> lock(fla_mutex); fla.Free(ptr); });
+
+				ConcurrentFreeListAllocator cfla;
+				cfla.Init(buffer);
+
+				const double concurrent_mops = RunThreads(thread_count,
+					[&cfla](const unsigned& size_in_bytes) { return cfla.Allocate(size_in_bytes); },
+					[&cfla](void* ptr) { cfla.Free(ptr); });
+
+				std::cout << "threads: " << thread_count << "   global mutex: " << locked_mops << " Mops/s   concurrent: " << concurrent_mops
+						  << " Mops/s   speedup: " << concurrent_mops / locked_mops << "x" << std::endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/***************************************************************************//**
+ * @filename BM_ConcurrentPoolAllocator.cpp
+ * @brief	 Contains the lock free and thread cached pool allocator benchmark
+ *			 function implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "Benchmarks.h"
+#include "PoolAllocator.h"
+#include "ConcurrentPoolAllocator.h"
+#include "ThreadCachedPoolAllocator.h"
+
+namespace BM
+{
+	namespace Allocator
+	{
+		constexpr unsigned MESSAGE_SIZE = 256u;
+		constexpr unsigned LIVE_MESSAGES_PER_THREAD = 64u;
+		constexpr unsigned MESSAGE_OPERATIONS_PER_THREAD = 500000u;
+
+		// Every thread frees and allocates messages at random slots, returns millions of operations (allocate + free) per second
+		template <typename AllocateFn, typename FreeFn>
+		static double RunMessageThreads(const unsigned& thread_count, AllocateFn&& allocate, FreeFn&& free)
+		{
+			std::vector<std::thread> threads;
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned t = 0u; t < thread_count; t++)
+			{
+				threads.emplace_back([&allocate, &free, t]()
+					{
+						std::mt19937 rng(42u + t);
+						std::vector<void*> messages(LIVE_MESSAGES_PER_THREAD, nullptr);
+
+						for (unsigned i = 0u; i < MESSAGE_OPERATIONS_PER_THREAD; i++)
+						{
+							void*& message = messages[rng() % LIVE_MESSAGES_PER_THREAD];
+							if (message != nullptr)
+								free(message);
+
+							// Touch the message like a worker filling it in would
+							message = allocate();
+							if (message != nullptr)
+								static_cast<unsigned*>(message)[1] = i;
+						}
+
+						for (void* message : messages)
+							if (message != nullptr)
+								free(message);
+					});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			return static_cast<double>(thread_count) * MESSAGE_OPERATIONS_PER_THREAD / ElapsedMs(start) / 1000.0;
+		}
+
+		void concurrentpool_throughput()
+		{
+			const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+			// Room for every live message plus a full magazine per thread
+			std::vector<std::byte> buffer(static_cast<size_t>(MESSAGE_SIZE) * (LIVE_MESSAGES_PER_THREAD + ThreadCachedPoolAllocator::DEFAULT_MAGAZINE_SIZE) * max_threads);
+
+			for (unsigned thread_count = 1u; thread_count <= max_threads; thread_count *= 2u)
+			{
+				// A single pool behind a global mutex, what we had before
+				PoolAllocator pa;
+				pa.Init(buffer, MESSAGE_SIZE);
+				std::mutex pa_mutex;
+
+				const double locked_mops = RunMessageThreads(thread_count,
+					[&pa, &pa_mutex]() { std::lock_guard<std::mutex> lock(pa_mutex); return pa.Allocate(); },
+					[&pa, &pa_mutex](void* ptr) { std::lock_guard<std::mutex> lock(pa_mutex); pa.Free(ptr); });
+
+				ConcurrentPoolAllocator cpa;
+				cpa.Init(buffer, MESSAGE_SIZE);
+
+				const double lock_free_mops = RunMessageThreads(thread_count,
+					[&cpa]() { return cpa.Allocate(); },
+					[&cpa](void* ptr) { cpa.Free(ptr); });
+
+				ThreadCachedPoolAllocator tcpa;
+				tcpa.Init(buffer, MESSAGE_SIZE);
+
+				const double magazine_mops = RunMessageThreads(thread_count,
+					[&tcpa]() { return tcpa.Allocate(); },
+					[&tcpa](void* ptr) { tcpa.Free(ptr); });
+
+				const double malloc_mops = RunMessageThreads(thread_count,
+					[]() { return std::malloc(MESSAGE_SIZE); },
+					[](void* ptr) { std::free(ptr); });
+
+				std::cout << "threads: " << thread_count << "   global mutex: " << locked_mops << " Mops/s   lock free: " << lock_free_mops
+						  << " Mops/s   magazines: " << magazine_mops << " Mops/s   malloc: " << malloc_mops << " Mops/s" << std::endl;
+			}
+		}
+
+		void concurrentpool_magazine_size()
+		{
+			const unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+			for (unsigned magazine_size = 1u; magazine_size <= 256u; magazine_size *= 4u)
+			{
+				std::vector<std::byte> buffer(static_cast<size_t>(MESSAGE_SIZE) * (LIVE_MESSAGES_PER_THREAD + magazine_size) * thread_count);
+				ThreadCachedPoolAllocator tcpa;
+				tcpa.Init(buffer, MESSAGE_SIZE, magazine_size);
+
+				const double magazine_mops = RunMessageThreads(thread_count,
+					[&tcpa]() { return tcpa.Allocate(); },
+					[&tcpa](void* ptr) { tcpa.Free(ptr); });
+
+				std::cout << "threads: " << thread_count << "   magazine size: " << magazine_size << "   " << magazine_mops << " Mops/s" << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
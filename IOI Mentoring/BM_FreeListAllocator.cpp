@@ -0,0 +1,109 @@
+/***************************************************************************//**
+ * @filename BM_FreeListAllocator.cpp
+ * @brief	 Contains the free list allocator benchmark function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "Benchmarks.h"
+#include "FreeListAllocator.h"
+
+namespace BM
+{
+	namespace Allocator
+	{
+		void freelist_scan_length()
+		{
+			constexpr unsigned BUFFER_SIZE = 1u << 22;
+			constexpr unsigned LIVE_CHUNKS = 8192u;
+			constexpr unsigned OPERATIONS = 200000u;
+
+			std::vector<std::byte> buffer(BUFFER_SIZE);
+
+			const std::array<std::pair<std::string, FreeListAllocator::e_AllocType>, 3> alloc_types =
+			{
+				std::make_pair("FIRST FIT", FreeListAllocator::e_AllocType::e_firstfit),
+				std::make_pair("BEST FIT ", FreeListAllocator::e_AllocType::e_bestfit),
+				std::make_pair("NEXT FIT ", FreeListAllocator::e_AllocType::e_nextfit),
+			};
+
+			for (const std::pair<std::string, FreeListAllocator::e_AllocType>& alloc_type : alloc_types)
+			{
+				FreeListAllocator fla(FreeListAllocator::e_AllocType(alloc_type.second));
+				fla.Init(buffer);
+
+				// Same sequence for every alloc type, mostly small chunks with the odd large one to leave splinters behind
+				std::mt19937 rng(42u);
+				std::vector<void*> chunks(LIVE_CHUNKS, nullptr);
+				unsigned allocations = 0u, failed_allocations = 0u;
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for (unsigned i = 0u; i < OPERATIONS; i++)
+				{
+					void*& chunk = chunks[rng() % LIVE_CHUNKS];
+					if (chunk != nullptr)
+						fla.Free(chunk);
+
+					const unsigned size_in_bytes = rng() % 16u == 0u ? 256u + rng() % 1024u : 12u + rng() % 116u;
+					chunk = fla.Allocate(size_in_bytes);
+
+					allocations++;
+					if (chunk == nullptr)
+						failed_allocations++;
+				}
+				const double elapsed_ms = ElapsedMs(start);
+
+				std::cout << alloc_type.first << "   avg scan length: " << static_cast<double>(fla.GetSearchLength()) / allocations
+						  << "   free chunks: " << fla.GetStats().m_free_chunk_count << "   failed: " << failed_allocations
+						  << "   time: " << elapsed_ms << " ms" << std::endl;
+			}
+		}
+
+		// Same sequence as freelist_scan_length, returns the time it took in ms
+		template <typename Allocator>
+		static double RunFragmentingSequence(Allocator& allocator)
+		{
+			constexpr unsigned LIVE_CHUNKS = 8192u;
+			constexpr unsigned OPERATIONS = 200000u;
+
+			std::mt19937 rng(42u);
+			std::vector<void*> chunks(LIVE_CHUNKS, nullptr);
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned i = 0u; i < OPERATIONS; i++)
+			{
+				void*& chunk = chunks[rng() % LIVE_CHUNKS];
+				if (chunk != nullptr)
+					allocator.Free(chunk);
+
+				chunk = allocator.Allocate(rng() % 16u == 0u ? 256u + rng() % 1024u : 12u + rng() % 116u);
+			}
+
+			return ElapsedMs(start);
+		}
+
+		template <typename Policy>
+		static void CompareDispatch(const std::string& name, FreeListAllocator::e_AllocType&& alloc_type, std::vector<std::byte>& buffer)
+		{
+			FreeListAllocator fla(std::move(alloc_type));
+			fla.Init(buffer);
+			const double runtime_ms = RunFragmentingSequence(fla);
+
+			BasicFreeListAllocator<Policy> fla_static;
+			fla_static.Init(buffer);
+			const double static_ms = RunFragmentingSequence(fla_static);
+
+			std::cout << name << "   runtime: " << runtime_ms << " ms   compile time: " << static_ms << " ms   speedup: " << runtime_ms / static_ms << "x" << std::endl;
+		}
+
+		void freelist_policy_dispatch()
+		{
+			std::vector<std::byte> buffer(1u << 22);
+
+			CompareDispatch<FirstFitPolicy>("FIRST FIT", FreeListAllocator::e_AllocType::e_firstfit, buffer);
+			CompareDispatch<BestFitPolicy>("BEST FIT ", FreeListAllocator::e_AllocType::e_bestfit, buffer);
+			CompareDispatch<NextFitPolicy>("NEXT FIT ", FreeListAllocator::e_AllocType::e_nextfit, buffer);
+		}
+	}
+}
@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ * @filename BM_PoolAllocator.cpp
+ * @brief	 Contains the pool allocator benchmark function implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "Benchmarks.h"
+#include "PoolAllocator.h"
+
+namespace BM
+{
+	namespace Allocator
+	{
+		void pool_free_check()
+		{
+			constexpr unsigned CHUNK_SIZE = 16u;
+
+			for (unsigned chunk_count = 1u << 10; chunk_count <= 1u << 20; chunk_count <<= 2)
+			{
+				std::vector<std::byte> buffer(static_cast<size_t>(chunk_count) * CHUNK_SIZE);
+				PoolAllocator pa;
+				pa.Init(buffer, CHUNK_SIZE);
+
+				std::vector<void*> chunks(chunk_count);
+				for (void*& chunk : chunks)
+					chunk = pa.Allocate();
+
+				// Random order so the free list ends up shuffled, then every chunk is freed twice
+				std::shuffle(chunks.begin(), chunks.end(), std::mt19937(42u));
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for (void* chunk : chunks)
+					pa.Free(chunk);
+				const double free_ms = ElapsedMs(start);
+
+				const std::chrono::steady_clock::time_point double_free_start = std::chrono::steady_clock::now();
+				for (void* chunk : chunks)
+					pa.Free(chunk);
+				const double double_free_ms = ElapsedMs(double_free_start);
+
+				std::cout << "chunks: " << chunk_count << "   free: " << free_ms * 1e6 / chunk_count << " ns   double free caught: "
+						  << double_free_ms * 1e6 / chunk_count << " ns   free chunks: " << pa.GetFreeChunkAmount() << std::endl;
+			}
+		}
+
+		void pool_init()
+		{
+			constexpr unsigned CHUNK_SIZE = 64u;
+
+			for (size_t buffer_size = size_t(1u) << 24; buffer_size <= size_t(1u) << 30; buffer_size <<= 2)
+			{
+				// Fresh pages every time, so first touches are part of what is measured
+				std::unique_ptr<std::byte[]> buffer = std::make_unique_for_overwrite<std::byte[]>(buffer_size);
+				PoolAllocator pa;
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				pa.Init(std::span<std::byte>(buffer.get(), buffer_size), CHUNK_SIZE);
+				const double init_ms = ElapsedMs(start);
+
+				const std::chrono::steady_clock::time_point clear_start = std::chrono::steady_clock::now();
+				pa.Clear();
+				const double clear_ms = ElapsedMs(clear_start);
+
+				// Only the chunks used pay for being carved
+				const std::chrono::steady_clock::time_point allocate_start = std::chrono::steady_clock::now();
+				for (unsigned i = 0u; i < 1000u; i++)
+					pa.Allocate();
+				const double allocate_ms = ElapsedMs(allocate_start);
+
+				std::cout << "buffer: " << (buffer_size >> 20) << " MiB   init: " << init_ms << " ms   clear: " << clear_ms
+						  << " ms   first 1000 allocations: " << allocate_ms << " ms" << std::endl;
+			}
+		}
+
+		void pool_batch()
+		{
+			constexpr unsigned CHUNK_SIZE = 64u;
+			constexpr unsigned ROUNDS = 20000u;
+
+			std::vector<std::byte> buffer(static_cast<size_t>(CHUNK_SIZE) * 4096u);
+
+			for (unsigned batch_size = 64u; batch_size <= 256u; batch_size *= 2u)
+			{
+				std::vector<void*> chunks(batch_size);
+
+				// Every round takes a batch and gives it back, half of it in the reverse order so the free list gets mixed up
+				PoolAllocator pa;
+				pa.Init(buffer, CHUNK_SIZE);
+
+				const std::chrono::steady_clock::time_point loop_start = std::chrono::steady_clock::now();
+				for (unsigned round = 0u; round < ROUNDS; round++)
+				{
+					for (void*& chunk : chunks)
+						chunk = pa.Allocate();
+					std::reverse(chunks.begin(), chunks.begin() + batch_size / 2u);
+					for (void* chunk : chunks)
+						pa.Free(chunk);
+				}
+				const double loop_ms = ElapsedMs(loop_start);
+
+				pa.Clear();
+
+				const std::chrono::steady_clock::time_point batch_start = std::chrono::steady_clock::now();
+				for (unsigned round = 0u; round < ROUNDS; round++)
+				{
+					pa.AllocateN(chunks);
+					std::reverse(chunks.begin(), chunks.begin() + batch_size / 2u);
+					pa.FreeN(chunks);
+				}
+				const double batch_ms = ElapsedMs(batch_start);
+
+				std::cout << "batch: " << batch_size << "   loop: " << loop_ms * 1e6 / ROUNDS / batch_size << " ns/chunk   AllocateN & FreeN: "
+						  << batch_ms * 1e6 / ROUNDS / batch_size << " ns/chunk   speedup: " << loop_ms / batch_ms << "x" << std::endl;
+			}
+		}
+
+		void pool_false_sharing()
+		{
+			constexpr unsigned INCREMENTS_PER_THREAD = 20000000u;
+
+			const unsigned thread_count = std::max(2u, std::thread::hardware_concurrency());
+			std::vector<std::byte> buffer(static_cast<size_t>(PoolAllocator::CACHE_LINE_SIZE) * thread_count * 2u);
+
+			// Every thread gets a counter from the pool and bumps it, the only difference is how far apart the counters are
+			const std::array<std::pair<std::string, bool>, 2> modes = { std::make_pair("packed  ", false), std::make_pair("isolated", true) };
+			for (const std::pair<std::string, bool>& mode : modes)
+			{
+				PoolAllocator pa;
+				pa.Init(buffer, sizeof(std::atomic<uint64_t>), alignof(std::atomic<uint64_t>), mode.second);
+
+				std::vector<std::atomic<uint64_t>*> counters;
+				for (unsigned t = 0u; t < thread_count; t++)
+					counters.push_back(new (pa.Allocate()) std::atomic<uint64_t>(0u));
+
+				std::vector<std::thread> threads;
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				for (unsigned t = 0u; t < thread_count; t++)
+				{
+					threads.emplace_back([counter = counters[t]]()
+						{
+							for (unsigned i = 0u; i < INCREMENTS_PER_THREAD; i++)
+								counter->fetch_add(1u, std::memory_order_relaxed);
+						});
+				}
+
+				for (std::thread& thread : threads)
+					thread.join();
+				const double elapsed_ms = ElapsedMs(start);
+
+				std::cout << mode.first << "   threads: " << thread_count << "   chunk size: " << pa.GetChunkSize() << "   time: " << elapsed_ms
+						  << " ms   " << elapsed_ms * 1e6 / INCREMENTS_PER_THREAD << " ns/increment" << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
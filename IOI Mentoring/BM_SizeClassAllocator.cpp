@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ * @filename BM_SizeClassAllocator.cpp
+ * @brief	 Contains the size class small object allocator benchmark function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "Benchmarks.h"
+#include "SizeClassAllocator.h"
+#include "FreeListAllocator.h"
+#include "SegregatedFreeListAllocator.h"
+
+namespace BM
+{
+	namespace Allocator
+	{
+		constexpr unsigned SMALL_LIVE_CHUNKS = 8192u;
+		constexpr unsigned SMALL_OPERATIONS = 1000000u;
+
+		// Same random free & allocate sequence for every allocator, returns millions of operations (allocate + free) per second
+		template <typename AllocateFn, typename FreeFn>
+		static double RunSmallObjects(AllocateFn&& allocate, FreeFn&& free)
+		{
+			// A handful of common sizes with the odd larger one, all under 1 KiB
+			constexpr std::array<unsigned, 8> SIZES = { 16u, 24u, 32u, 48u, 64u, 96u, 128u, 200u };
+
+			std::mt19937 rng(42u);
+			std::vector<void*> chunks(SMALL_LIVE_CHUNKS, nullptr);
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned i = 0u; i < SMALL_OPERATIONS; i++)
+			{
+				void*& chunk = chunks[rng() % SMALL_LIVE_CHUNKS];
+				if (chunk != nullptr)
+					free(chunk);
+
+				chunk = allocate(rng() % 64u == 0u ? 256u + rng() % 768u : SIZES[rng() % SIZES.size()]);
+			}
+			const double elapsed_ms = ElapsedMs(start);
+
+			for (void* chunk : chunks)
+				if (chunk != nullptr)
+					free(chunk);
+
+			return SMALL_OPERATIONS / elapsed_ms / 1000.0;
+		}
+
+		void sizeclass_small_objects()
+		{
+			std::vector<std::byte> buffer(1u << 24);
+
+			SizeClassAllocator sca;
+			sca.Init(buffer);
+			const double size_class_mops = RunSmallObjects(
+				[&sca](const unsigned& size_in_bytes) { return sca.Allocate(size_in_bytes); },
+				[&sca](void* ptr) { sca.Free(ptr); });
+
+			FreeListAllocator first_fit(FreeListAllocator::e_AllocType::e_firstfit);
+			first_fit.Init(buffer);
+			const double first_fit_mops = RunSmallObjects(
+				[&first_fit](const unsigned& size_in_bytes) { return first_fit.Allocate(size_in_bytes); },
+				[&first_fit](void* ptr) { first_fit.Free(ptr); });
+
+			FreeListAllocator best_fit(FreeListAllocator::e_AllocType::e_bestfit);
+			best_fit.Init(buffer);
+			const double best_fit_mops = RunSmallObjects(
+				[&best_fit](const unsigned& size_in_bytes) { return best_fit.Allocate(size_in_bytes); },
+				[&best_fit](void* ptr) { best_fit.Free(ptr); });
+
+			SegregatedFreeListAllocator sfla;
+			sfla.Init(buffer);
+			const double segregated_mops = RunSmallObjects(
+				[&sfla](const unsigned& size_in_bytes) { return sfla.Allocate(size_in_bytes); },
+				[&sfla](void* ptr) { sfla.Free(ptr); });
+
+			std::cout << "size classes: " << size_class_mops << " Mops/s   first fit: " << first_fit_mops << " Mops/s   best fit: " << best_fit_mops
+					  << " Mops/s   segregated fit: " << segregated_mops << " Mops/s" << std::endl;
+		}
+	}
+}
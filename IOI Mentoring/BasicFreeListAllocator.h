@@ -0,0 +1,363 @@
+/***************************************************************************//**
+ * @filename BasicFreeListAllocator.h
+ * @brief	 Contains the free list allocator class template, the allocation
+ *			 policy is a template parameter.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "FreeListAllocatorBase.h"
+#include "FreeListPolicies.h"
+
+// The policy keeps the free chunks indexed and finds the one to allocate at (see FreeListPolicies.h). Knowing it at compile time lets
+// the search be inlined into Allocate, FreeListAllocator uses RuntimeFitPolicy for when it has to be picked at runtime.
+template <typename Policy>
+class BasicFreeListAllocator : public FreeListAllocatorBase
+{
+public:
+	// Uses the smallest granularity the buffer size allows, see CalculateGranularity
+	void Init(std::span<std::byte>&& memory_buffer);
+
+	// Chunks take whole granules of the given size (1, or a power of two from 16 bytes up), larger granules reach larger buffers
+	// and keep every payload aligned to them. Bytes at either end of the buffer that dont make up a granule are not used.
+	void Init(std::span<std::byte>&& memory_buffer, const size_t& granularity);
+
+	void* Allocate(size_t size_in_bytes, const size_t& alignment = 0u);
+
+	// Resizes in place when it can (shrinking, or growing into the next chunk if it is free), otherwise allocates a new chunk with
+	// the given alignment and copies the data over. Like realloc, returns nullptr and keeps the old chunk if it fails.
+	void* Reallocate(void* ptr, const size_t& size_in_bytes, const size_t& alignment = 0u);
+
+	void Free(void* ptr);
+
+	void Clear();
+
+protected:
+	void* AllocateAtChunk(size_t size_in_bytes, FreeListFreeHeader* free_chunk, const size_t& alignment);
+
+	// Keep the stats and the policy's index up to date
+	void InsertFreeChunk(FreeListFreeHeader* chunk);
+	void RemoveFreeChunk(FreeListFreeHeader* chunk);
+	void ReplaceFreeChunk(FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk);
+	void ResizeFreeChunk(FreeListFreeHeader* chunk, const size_t& chunk_size);
+	void RebuildFreeChunkIndex();
+
+	Policy m_policy{};
+};
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::Init(std::span<std::byte>&& memory_buffer)
+{
+	const size_t granularity = CalculateGranularity(memory_buffer.size());
+	Init(std::forward<std::span<std::byte>>(memory_buffer), granularity);
+}
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::Init(std::span<std::byte>&& memory_buffer, const size_t& granularity)
+{
+	// InitBuffer already reported what is wrong with it
+	if (!InitBuffer(std::forward<std::span<std::byte>>(memory_buffer), granularity))
+	{
+		assert(0);
+		return;
+	}
+
+	Clear();
+}
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::InsertFreeChunk(FreeListFreeHeader* chunk)
+{
+	AddFreeChunkStats(GetChunkSize(chunk));
+	m_policy.Insert(*this, chunk);
+}
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::RemoveFreeChunk(FreeListFreeHeader* chunk)
+{
+	RemoveFreeChunkStats(GetChunkSize(chunk));
+	m_policy.Remove(*this, chunk);
+}
+
+// new_chunk's size has to be set already and old_chunk's header has to be intact
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::ReplaceFreeChunk(FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk)
+{
+	RemoveFreeChunkStats(GetChunkSize(old_chunk));
+	AddFreeChunkStats(GetChunkSize(new_chunk));
+	m_policy.Replace(*this, old_chunk, new_chunk);
+}
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::ResizeFreeChunk(FreeListFreeHeader* chunk, const size_t& chunk_size)
+{
+	RemoveFreeChunkStats(GetChunkSize(chunk));
+	AddFreeChunkStats(chunk_size);
+	m_policy.Resize(*this, chunk, EncodeChunkSize(chunk_size));
+}
+
+// Walks the buffer and puts every free chunk in the policy's index
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::RebuildFreeChunkIndex()
+{
+	m_policy.Clear();
+
+	// The chunks are counted again as they are inserted
+	m_stats.m_bytes_free = 0u;
+	m_stats.m_free_chunk_count = 0u;
+	m_stats.m_free_size_class_bitmap = 0u;
+	m_stats.m_free_size_classes.fill(0u);
+
+	ForEachFreeChunk([this](FreeListFreeHeader* chunk) { InsertFreeChunk(chunk); });
+}
+
+// Allocates data of the given size inside the given free chunk, size_in_bytes does not include headersize
+template <typename Policy>
+void* BasicFreeListAllocator<Policy>::AllocateAtChunk(size_t size_in_bytes, FreeListFreeHeader* free_chunk, const size_t& alignment)
+{
+	unsigned padding = CalculateAlignmentPadding(free_chunk, alignment);
+	unsigned prev_free_flag = 0u;
+
+	// If the padding in front of the aligned payload can hold a free chunk give it back, the allocated chunk starts right after it
+	if (padding >= MIN_FREE_CHUNK_SIZE)
+	{
+		std::byte* free_chunk_start = reinterpret_cast<std::byte*>(free_chunk);
+
+		// Payloads are granule aligned, so when the padding isnt 0 it is a whole number of granules
+		FreeListFreeHeader* aligned_free_chunk = new (free_chunk_start + padding) FreeListFreeHeader(EncodeChunkSize(GetChunkSize(free_chunk) - padding));
+		ReplaceFreeChunk(free_chunk, aligned_free_chunk);
+
+		FreeListFreeHeader* leading_free_chunk = new (free_chunk_start) FreeListFreeHeader(EncodeChunkSize(padding - SIZE_ALLOC_HEADER));
+		new (free_chunk_start + padding - SIZE_FREE_FOOTER) FreeListFreeFooter(leading_free_chunk->m_chunk_size);
+		InsertFreeChunk(leading_free_chunk);
+
+		free_chunk = aligned_free_chunk;
+		padding = 0u;
+		prev_free_flag = FLAG_PREV_FREE;
+	}
+
+	// The padding is part of the allocated chunk so Free gives it back
+	size_in_bytes += padding;
+
+	// If we cant fit a free chunk with the remaining memory, extend the allocated chunk by however much we have extra
+	const size_t free_chunk_size = GetChunkSize(free_chunk);
+	if (free_chunk_size - size_in_bytes <= MIN_FREE_CHUNK_SIZE)
+	{
+		size_in_bytes = free_chunk_size;
+		RemoveFreeChunk(free_chunk);
+
+		// The next chunk no longer has a free neighbour behind it
+		if (FreeListAllocHeader* next_chunk = GetNextChunk(free_chunk))
+			next_chunk->m_chunk_size &= ~FLAG_PREV_FREE;
+	}
+	// Create a free chunk with the remaining memory, it takes the place of the chunk we are allocating at in the free list
+	else
+	{
+		std::byte* remaining_chunk_start = reinterpret_cast<std::byte*>(free_chunk) + SIZE_ALLOC_HEADER + size_in_bytes;
+		const size_t remaining_chunk_size = free_chunk_size - size_in_bytes - SIZE_ALLOC_HEADER;
+
+		FreeListFreeHeader* remaining_chunk = new (remaining_chunk_start) FreeListFreeHeader(EncodeChunkSize(remaining_chunk_size));
+		new (remaining_chunk_start + SIZE_ALLOC_HEADER + remaining_chunk_size - SIZE_FREE_FOOTER) FreeListFreeFooter(remaining_chunk->m_chunk_size);
+		ReplaceFreeChunk(free_chunk, remaining_chunk);
+	}
+
+	// Free chunks never have a free previous chunk as they would have been merged, unless we just gave back the leading padding
+	std::byte* payload = reinterpret_cast<std::byte*>(new (free_chunk) FreeListAllocHeader(EncodeChunkSize(size_in_bytes) | FLAG_IN_USE | prev_free_flag)) + SIZE_ALLOC_HEADER + padding;
+
+	// Let Free know how far back the alloc header is
+	if (padding != 0u)
+		new (payload - sizeof(ALIGN_TAG)) unsigned(ALIGN_TAG | padding);
+
+	m_stats.m_alloc_chunk_count++;
+	UpdateInUseStats();
+
+	// Pointer to allocated chunk, add the size of the alloc header as that is where the user can actually allocate memory
+	return payload;
+}
+
+template <typename Policy>
+void* BasicFreeListAllocator<Policy>::Allocate(size_t size_in_bytes, const size_t& alignment)
+{
+	if (size_in_bytes == 0u)
+		return nullptr;
+
+	// Having an allocation size + alloc header being less than the free chunk size may lead to having chunks of memory that cannot be labelled as free.
+	// Granules always fit a free chunk, so this only happens with plain byte sizes.
+	if (size_in_bytes + SIZE_ALLOC_HEADER < MIN_FREE_CHUNK_SIZE && GetGranularity() == 1u)
+	{
+		debug_print("WARNING [BasicFreeListAllocator.h, BasicFreeListAllocator, void* Allocate(size_t, const size_t&)]: Allocation size cannot be less than 12 bytes (MIN_FREE_CHUNK_SIZE - SIZE_ALLOC_HEADER).");
+		size_in_bytes = MIN_FREE_CHUNK_SIZE;
+	}
+
+	if (size_in_bytes > GetMaxChunkSize() || alignment > SIZE_MASK)
+		return nullptr;
+
+	// Chunks take whole granules
+	size_in_bytes = RoundChunkSize(size_in_bytes);
+
+	// The policy is known at compile time so its search gets inlined here
+	FreeListFreeHeader* free_chunk = m_policy.Find(*this, size_in_bytes, alignment, m_search_length);
+
+	return free_chunk != nullptr ? AllocateAtChunk(size_in_bytes, free_chunk, alignment) : nullptr;
+}
+
+template <typename Policy>
+void* BasicFreeListAllocator<Policy>::Reallocate(void* ptr, const size_t& size_in_bytes, const size_t& alignment)
+{
+	// Same as realloc, a nullptr is a new allocation and a size of 0 frees the chunk
+	if (ptr == nullptr)
+		return Allocate(size_in_bytes, alignment);
+
+	if (size_in_bytes == 0u)
+	{
+		Free(ptr);
+		return nullptr;
+	}
+
+	if (size_in_bytes > GetMaxChunkSize())
+		return nullptr;
+
+	FreeListAllocHeader* alloc_chunk = GetAllocHeader(ptr);
+	if (alloc_chunk == nullptr)
+		return nullptr;
+
+	// The payload doesnt move when resizing in place, so neither does the padding of aligned allocations
+	const size_t padding = static_cast<size_t>(static_cast<std::byte*>(ptr) - reinterpret_cast<std::byte*>(alloc_chunk)) - SIZE_ALLOC_HEADER;
+	const size_t chunk_size = GetChunkSize(alloc_chunk);
+
+	// Same as in Allocate, the chunk has to be able to hold a free chunk once it is freed and take whole granules
+	const size_t new_chunk_size = RoundChunkSize(std::max<size_t>(size_in_bytes + padding, MIN_FREE_CHUNK_SIZE - SIZE_ALLOC_HEADER));
+
+	// We can only stay in place if the payload already has the alignment asked for
+	if (alignment == 0u || reinterpret_cast<uintptr_t>(ptr) % alignment == 0u)
+	{
+		FreeListAllocHeader* next_chunk = GetNextChunk(alloc_chunk);
+		FreeListFreeHeader* next_free_chunk = next_chunk != nullptr && !(next_chunk->m_chunk_size & FLAG_IN_USE) ? reinterpret_cast<FreeListFreeHeader*>(next_chunk) : nullptr;
+
+		// Our chunk plus the next one if it is free, whatever we dont use of it ends up free again
+		const size_t available_size = chunk_size + (next_free_chunk != nullptr ? GetChunkSize(next_free_chunk) + SIZE_ALLOC_HEADER : 0u);
+		if (new_chunk_size <= available_size)
+		{
+			// The next free chunk's header is about to be moved or absorbed
+			if (next_free_chunk != nullptr)
+				RemoveFreeChunk(next_free_chunk);
+
+			const size_t remaining_size = available_size - new_chunk_size;
+
+			// Same as in AllocateAtChunk, if we cant fit a free chunk with the remaining memory keep it in the allocated chunk
+			if (remaining_size <= MIN_FREE_CHUNK_SIZE)
+			{
+				alloc_chunk->m_chunk_size = EncodeChunkSize(available_size) | (alloc_chunk->m_chunk_size & ~SIZE_MASK);
+
+				// If we absorbed the whole next chunk, the one after it no longer has a free neighbour behind it
+				if (next_free_chunk != nullptr)
+					if (FreeListAllocHeader* new_next_chunk = GetNextChunk(alloc_chunk))
+						new_next_chunk->m_chunk_size &= ~FLAG_PREV_FREE;
+			}
+			else
+			{
+				alloc_chunk->m_chunk_size = EncodeChunkSize(new_chunk_size) | (alloc_chunk->m_chunk_size & ~SIZE_MASK);
+
+				std::byte* remaining_chunk_start = reinterpret_cast<std::byte*>(alloc_chunk) + SIZE_ALLOC_HEADER + new_chunk_size;
+				FreeListFreeHeader* remaining_chunk = new (remaining_chunk_start) FreeListFreeHeader(EncodeChunkSize(remaining_size - SIZE_ALLOC_HEADER));
+				new (remaining_chunk_start + remaining_size - SIZE_FREE_FOOTER) FreeListFreeFooter(remaining_chunk->m_chunk_size);
+				InsertFreeChunk(remaining_chunk);
+
+				if (FreeListAllocHeader* new_next_chunk = GetNextChunk(remaining_chunk))
+					new_next_chunk->m_chunk_size |= FLAG_PREV_FREE;
+			}
+
+			UpdateInUseStats();
+			return ptr;
+		}
+	}
+
+	// No room to grow in place, move the data to a new chunk
+	void* new_ptr = Allocate(size_in_bytes, alignment);
+	if (new_ptr == nullptr)
+		return nullptr;
+
+	std::memcpy(new_ptr, ptr, std::min<size_t>(size_in_bytes, chunk_size - padding));
+	Free(ptr);
+
+	return new_ptr;
+}
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::Free(void* ptr)
+{
+	ptr = GetAllocHeader(ptr);
+	if (ptr == nullptr)
+		return;
+
+	const unsigned chunk_header = reinterpret_cast<FreeListAllocHeader*>(ptr)->m_chunk_size;
+	std::byte* chunk_start = static_cast<std::byte*>(ptr);
+	const size_t chunk_size = DecodeChunkSize(chunk_header);
+
+	// Check adjacency backwards, the previous chunk's footer tells us where it starts
+	FreeListFreeHeader* prev_free_chunk = nullptr;
+	if (chunk_header & FLAG_PREV_FREE)
+	{
+		const size_t prev_chunk_size = DecodeChunkSize(reinterpret_cast<FreeListFreeFooter*>(chunk_start - SIZE_FREE_FOOTER)->m_chunk_size);
+		prev_free_chunk = reinterpret_cast<FreeListFreeHeader*>(chunk_start - prev_chunk_size - SIZE_ALLOC_HEADER);
+	}
+
+	// Check adjacency forward, the next chunk's header tells us if it is free
+	FreeListFreeHeader* next_free_chunk = nullptr;
+	FreeListAllocHeader* next_chunk = GetNextChunk(ptr);
+	if (next_chunk != nullptr && !(next_chunk->m_chunk_size & FLAG_IN_USE))
+		next_free_chunk = reinterpret_cast<FreeListFreeHeader*>(next_chunk);
+
+	FreeListFreeHeader* new_free_chunk = nullptr;
+	if (prev_free_chunk != nullptr)
+	{
+		// Increase the size of the previous chunk accordingly, it keeps its place in the free list
+		size_t new_chunk_size = GetChunkSize(prev_free_chunk) + chunk_size + SIZE_ALLOC_HEADER;	// This is how much space an allocated chunk takes
+		if (next_free_chunk != nullptr)
+		{
+			RemoveFreeChunk(next_free_chunk);
+			new_chunk_size += GetChunkSize(next_free_chunk) + SIZE_ALLOC_HEADER;
+		}
+		ResizeFreeChunk(prev_free_chunk, new_chunk_size);
+		new_free_chunk = prev_free_chunk;
+
+		// Our alloc header is now in the middle of a free chunk, clear it so freeing the ptr again is caught
+		reinterpret_cast<FreeListAllocHeader*>(chunk_start)->m_chunk_size = 0u;
+	}
+	else if (next_free_chunk != nullptr)
+	{
+		// Our new free chunk absorbs the next one and takes its place in the free list
+		new_free_chunk = new (chunk_start) FreeListFreeHeader(EncodeChunkSize(chunk_size + GetChunkSize(next_free_chunk) + SIZE_ALLOC_HEADER));
+		ReplaceFreeChunk(next_free_chunk, new_free_chunk);
+	}
+	else
+	{
+		// No free neighbours, write our new free chunk into the buffer and put it at the front of the free list
+		new_free_chunk = new (chunk_start) FreeListFreeHeader(EncodeChunkSize(chunk_size));
+		InsertFreeChunk(new_free_chunk);
+	}
+
+	new (reinterpret_cast<std::byte*>(new_free_chunk) + SIZE_ALLOC_HEADER + GetChunkSize(new_free_chunk) - SIZE_FREE_FOOTER) FreeListFreeFooter(new_free_chunk->m_chunk_size);
+
+	// Let the next chunk know it now has a free neighbour behind it
+	if (FreeListAllocHeader* new_next_chunk = GetNextChunk(new_free_chunk))
+		new_next_chunk->m_chunk_size |= FLAG_PREV_FREE;
+
+	m_stats.m_alloc_chunk_count--;
+	UpdateInUseStats();
+}
+
+template <typename Policy>
+void BasicFreeListAllocator<Policy>::Clear()
+{
+	// Initialize free chunks, only chunk we have is the entire buffer
+	m_policy.Clear();
+	m_search_length = 0u;
+	m_stats = FreeListStats{};
+
+	const size_t chunk_size = m_buffer.size() - SIZE_ALLOC_HEADER;
+	FreeListFreeHeader* chunk = new (&m_buffer[0]) FreeListFreeHeader(EncodeChunkSize(chunk_size));
+	new (&m_buffer[SIZE_ALLOC_HEADER + chunk_size - SIZE_FREE_FOOTER]) FreeListFreeFooter(chunk->m_chunk_size);
+	InsertFreeChunk(chunk);
+}
@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ * @filename Benchmarks.cpp
+ * @brief	 Contains the benchmark container implementation and run benchmark
+ *           function implentation.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "Benchmarks.h"
+
+const std::array<std::string, 5> BM_TITLES = { "POOL ALLOCATOR", "CONCURRENT POOL ALLOCATOR", "SIZE CLASS ALLOCATOR", "FREE LIST ALLOCATOR", "CONCURRENT FREE LIST ALLOCATOR", };
+
+using namespace BM;
+using namespace Allocator;
+
+// Contains the benchmarks by categories
+std::unordered_map<e_BMTypes, std::vector<std::pair<std::string, void (*)()>>> benchmarks =
+{
+    std::make_pair
+    (
+        e_BMTypes::e_alloc_pool,
+        std::vector<std::pair<std::string, void (*)()>>
+        {
+            std::make_pair("FREE CHECK",        &pool_free_check),
+            std::make_pair("INIT",              &pool_init),
+            std::make_pair("BATCH",             &pool_batch),
+            std::make_pair("FALSE SHARING",     &pool_false_sharing),
+        }
+    ),
+    std::make_pair
+    (
+        e_BMTypes::e_alloc_concurrentpool,
+        std::vector<std::pair<std::string, void (*)()>>
+        {
+            std::make_pair("THROUGHPUT",        &concurrentpool_throughput),
+            std::make_pair("MAGAZINE SIZE",     &concurrentpool_magazine_size),
+        }
+    ),
+    std::make_pair
+    (
+        e_BMTypes::e_alloc_sizeclass,
+        std::vector<std::pair<std::string, void (*)()>>
+        {
+            std::make_pair("SMALL OBJECTS",     &sizeclass_small_objects),
+        }
+    ),
+    std::make_pair
+    (
+        e_BMTypes::e_alloc_freelist,
+        std::vector<std::pair<std::string, void (*)()>>
+        {
+            std::make_pair("SCAN LENGTH",       &freelist_scan_length),
+            std::make_pair("POLICY DISPATCH",   &freelist_policy_dispatch),
+        }
+    ),
+    std::make_pair
+    (
+        e_BMTypes::e_alloc_concurrentfreelist,
+        std::vector<std::pair<std::string, void (*)()>>
+        {
+            std::make_pair("SCALING",           &concurrentfreelist_scaling),
+        }
+    ),
+};
+
+void BM::RunBenchmarks(std::vector<BM::e_BMTypes>&& benchmark_types_to_run)
+{
+    for (unsigned i = 0u; i < benchmark_types_to_run.size(); i++)
+    {
+        std::cout << "--------------" + BM_TITLES[static_cast<int>(benchmark_types_to_run[i])] + "--------------" << std::endl;
+
+        for (unsigned j = 0u; j < benchmarks[benchmark_types_to_run[i]].size(); j++)
+        {
+            std::cout << benchmarks[benchmark_types_to_run[i]][j].first << ": " << std::endl;
+            benchmarks[benchmark_types_to_run[i]][j].second();
+            std::cout << "-------------------------" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/***************************************************************************//**
+ * @filename Benchmarks.h
+ * @brief	 Contains the benchmark function definitions, container and run
+ *			 benchmark function definition.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+
+namespace BM
+{
+	enum class e_BMTypes { e_alloc_pool, e_alloc_concurrentpool, e_alloc_sizeclass, e_alloc_freelist, e_alloc_concurrentfreelist };
+
+	namespace Allocator
+	{
+		void pool_free_check();					// Free and double free cost as the pool grows
+		void pool_init();						// Init & Clear cost as the pool grows
+		void pool_batch();						// Allocate & Free in a loop vs AllocateN & FreeN
+		void pool_false_sharing();				// Per thread counters in packed vs isolated chunks
+
+		void concurrentpool_throughput();		// Global mutex vs lock free vs magazines vs malloc, from 1 thread up to the core count
+		void concurrentpool_magazine_size();	// Thread cached pool throughput as the magazines grow
+
+		void sizeclass_small_objects();			// Size class pools vs free lists on small objects
+
+		void freelist_scan_length();			// First fit vs best fit vs next fit under fragmentation
+		void freelist_policy_dispatch();		// Runtime alloc type vs compile time policy
+
+		void concurrentfreelist_scaling();		// Global mutex vs thread caches, from 1 thread up to the core count
+	}
+
+	// Benchmarks print their own results, they are not pass/fail
+	void RunBenchmarks(std::vector<BM::e_BMTypes>&& benchmark_types_to_run = {
+																			   e_BMTypes::e_alloc_pool,
+																			   e_BMTypes::e_alloc_concurrentpool,
+																			   e_BMTypes::e_alloc_sizeclass,
+																			   e_BMTypes::e_alloc_freelist,
+																			   e_BMTypes::e_alloc_concurrentfreelist,
+																			});
+
+	// Milliseconds since the given time point
+	inline double ElapsedMs(const std::chrono::steady_clock::time_point& start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
@@ -0,0 +1,109 @@
+/***************************************************************************//**
+ * @filename ChainedLinearAllocator.cpp
+ * @brief	 Contains the chained linear allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "ChainedLinearAllocator.h"
+
+ChainedLinearAllocator::~ChainedLinearAllocator()
+{
+	ReleaseBlocks();
+}
+
+void ChainedLinearAllocator::Init(const size_t& initial_block_size, ISlabSource& upstream)
+{
+	if (initial_block_size == 0u)
+	{
+		debug_print("ERROR [ChainedLinearAllocator.cpp, ChainedLinearAllocator, void Init(const size_t&, ISlabSource&)]: Block size cannot be zero.");
+		return;
+	}
+
+	// Blocks of the previous Init go back to the source they came from
+	ReleaseBlocks();
+
+	m_upstream = &upstream;
+	m_next_block_size = initial_block_size;
+}
+
+void* ChainedLinearAllocator::AllocateFromNewBlock(const size_t& size_in_bytes, const size_t& alignment)
+{
+	if (size_in_bytes == 0u)
+	{
+		debug_print("ERROR [ChainedLinearAllocator.cpp, ChainedLinearAllocator, void* Allocate(const size_t&, const size_t&)]: Allocation size cannot be zero.");
+		return nullptr;
+	}
+
+	if (m_upstream == nullptr)
+	{
+		debug_print("ERROR [ChainedLinearAllocator.cpp, ChainedLinearAllocator, void* Allocate(const size_t&, const size_t&)]: Allocator was not initialized.");
+		return nullptr;
+	}
+
+	// Blocks are aligned to BLOCK_ALIGNMENT, larger alignments may need padding at the start of the block
+	const size_t padding = alignment > BLOCK_ALIGNMENT ? alignment - BLOCK_ALIGNMENT : 0u;
+	const size_t block_size = std::max(m_next_block_size, size_in_bytes + padding);
+
+	std::byte* memory = static_cast<std::byte*>(m_upstream->AllocateSlab(block_size, BLOCK_ALIGNMENT));
+	if (memory == nullptr)
+	{
+		debug_print("ERROR [ChainedLinearAllocator.cpp, ChainedLinearAllocator, void* Allocate(const size_t&, const size_t&)]: Upstream source has no memory left.");
+		return nullptr;
+	}
+
+	m_blocks.push_back(Block{ memory, block_size });
+	m_next_block_size = block_size * 2u;
+
+	m_cursor = memory;
+	m_end = memory + block_size;
+
+	// Fits for sure now
+	return Allocate(size_in_bytes, alignment);
+}
+
+void ChainedLinearAllocator::Free()
+{
+	// Linear allocators just clear the whole buffer
+	Clear();
+}
+
+void ChainedLinearAllocator::Clear()
+{
+	if (m_blocks.empty())
+		return;
+
+	// The largest block is enough for most of what was allocated until now, the others go back
+	auto largest = std::max_element(m_blocks.begin(), m_blocks.end(), [](const Block& a, const Block& b) { return a.m_size < b.m_size; });
+	const Block kept = *largest;
+
+	for (const Block& block : m_blocks)
+		if (block.m_memory != kept.m_memory)
+			m_upstream->FreeSlab(block.m_memory, block.m_size, BLOCK_ALIGNMENT);
+
+	m_blocks.assign(1u, kept);
+	m_next_block_size = kept.m_size * 2u;
+
+	m_cursor = kept.m_memory;
+	m_end = kept.m_memory + kept.m_size;
+}
+
+size_t ChainedLinearAllocator::GetCapacity() const
+{
+	size_t capacity = 0u;
+	for (const Block& block : m_blocks)
+		capacity += block.m_size;
+
+	return capacity;
+}
+
+void ChainedLinearAllocator::ReleaseBlocks()
+{
+	for (const Block& block : m_blocks)
+		m_upstream->FreeSlab(block.m_memory, block.m_size, BLOCK_ALIGNMENT);
+
+	m_blocks.clear();
+	m_cursor = nullptr;
+	m_end = nullptr;
+}
@@ -0,0 +1,105 @@
+/***************************************************************************//**
+ * @filename ChainedLinearAllocator.h
+ * @brief	 Contains the chained linear allocator class header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "SlabSource.h"
+
+// Linear allocator that takes a new block from its upstream source when the current one is full, instead of failing. Every new block
+// is twice as large as the previous one (or as large as the allocation if that is larger), so a few blocks cover any request size. The
+// rest of a full block is left unused. Bumping the offset is inline, getting a new block is out of line.
+class ChainedLinearAllocator : public IAllocator
+{
+public:
+	static constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+	ChainedLinearAllocator() = default;
+	~ChainedLinearAllocator();
+
+	ChainedLinearAllocator(const ChainedLinearAllocator&) = delete;
+	ChainedLinearAllocator& operator=(const ChainedLinearAllocator&) = delete;
+
+	// Blocks are taken when needed, Init doesnt allocate. The upstream source has to outlive the allocator.
+	void Init(const size_t& initial_block_size, ISlabSource& upstream = HeapSlabSource::Get());
+
+	// alignment has to be 0 (none) or a power of two
+	void* Allocate(const size_t& size_in_bytes, const size_t& alignment = 0u)
+	{
+		// Checked before bumping, a bad mask would give back a misaligned ptr while the block has room
+		if (alignment != 0u && !std::has_single_bit(alignment))
+		{
+			debug_print("ERROR [ChainedLinearAllocator.h, ChainedLinearAllocator, void* Allocate(const size_t&, const size_t&)]: Alignment has to be a power of two.");
+			return nullptr;
+		}
+
+		const uintptr_t cursor = reinterpret_cast<uintptr_t>(m_cursor);
+		return Bump(size_in_bytes, alignment != 0u ? AlignForward(cursor, alignment) : cursor, alignment);
+	}
+
+	template <size_t ALIGNMENT>
+	void* Allocate(const size_t& size_in_bytes)
+	{
+		static_assert(std::has_single_bit(ALIGNMENT), "Alignment has to be a power of two.");
+		return Bump(size_in_bytes, AlignForward(reinterpret_cast<uintptr_t>(m_cursor), ALIGNMENT), ALIGNMENT);
+	}
+
+	void Free();
+
+	// Keeps the largest block and gives the others back upstream
+	void Clear();
+
+	size_t GetBlockCount() const
+	{
+		return m_blocks.size();
+	}
+
+	// Bytes in all the blocks
+	size_t GetCapacity() const;
+
+	size_t GetCurrentBlockSize() const
+	{
+		return m_blocks.empty() ? 0u : m_blocks.back().m_size;
+	}
+
+	// Bytes used in the current block
+	size_t GetOffset() const
+	{
+		return m_blocks.empty() ? 0u : static_cast<size_t>(m_cursor - m_blocks.back().m_memory);
+	}
+
+private:
+	struct Block
+	{
+		std::byte* m_memory = nullptr;
+		size_t m_size = 0u;
+	};
+
+	// Fast path, address is the cursor already aligned
+	void* Bump(const size_t& size_in_bytes, const uintptr_t& address, const size_t& alignment)
+	{
+		const uintptr_t end = reinterpret_cast<uintptr_t>(m_end);
+		if (size_in_bytes != 0u && address <= end && size_in_bytes <= end - address)
+		{
+			m_cursor = reinterpret_cast<std::byte*>(address + size_in_bytes);
+			return reinterpret_cast<void*>(address);
+		}
+
+		return AllocateFromNewBlock(size_in_bytes, alignment);
+	}
+
+	void* AllocateFromNewBlock(const size_t& size_in_bytes, const size_t& alignment);
+
+	void ReleaseBlocks();
+
+	std::vector<Block> m_blocks;		// The current block is the last one
+	size_t m_next_block_size = 0u;
+
+	std::byte* m_cursor = nullptr;
+	std::byte* m_end = nullptr;
+
+	ISlabSource* m_upstream = nullptr;
+};
@@ -0,0 +1,331 @@
+/***************************************************************************//**
+ * @filename ConcurrentFreeListAllocator.cpp
+ * @brief	 Contains the thread safe free list allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "ConcurrentFreeListAllocator.h"
+
+// Arenas are a multiple of this so two arenas never share a cache line
+constexpr size_t ARENA_ALIGNMENT = 64u;
+
+static std::atomic<unsigned> s_next_allocator_id{ 1u };
+
+// Cache of the calling thread in the last allocator it used, saves looking through the caches on every call
+static thread_local unsigned t_allocator_id = 0u;
+static thread_local unsigned t_thread_cache = 0u;
+
+// Initialized allocators by id, so an exiting thread only flushes into allocators that still exist
+static std::mutex s_live_allocators_mutex;
+static std::unordered_map<unsigned, ConcurrentFreeListAllocator*> s_live_allocators;
+
+namespace
+{
+	// Destroyed when its thread exits, flushes and releases the caches the thread claimed so they dont run out
+	struct FreeListThreadExitFlush
+	{
+		~FreeListThreadExitFlush()
+		{
+			std::lock_guard<std::mutex> lock(s_live_allocators_mutex);
+			for (const unsigned& allocator_id : m_allocator_ids)
+			{
+				auto it = s_live_allocators.find(allocator_id);
+				if (it != s_live_allocators.end())
+					it->second->FlushThreadCache();
+			}
+		}
+
+		std::vector<unsigned> m_allocator_ids;
+	};
+}
+
+static thread_local FreeListThreadExitFlush t_exit_flush;
+
+ConcurrentFreeListAllocator::~ConcurrentFreeListAllocator()
+{
+	std::lock_guard<std::mutex> lock(s_live_allocators_mutex);
+	s_live_allocators.erase(m_id);
+}
+
+void ConcurrentFreeListAllocator::Init(std::span<std::byte>&& memory_buffer, const unsigned& arena_count)
+{
+	if (arena_count == 0u)
+	{
+		debug_print("ERROR [ConcurrentFreeListAllocator.cpp, ConcurrentFreeListAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Arena count cannot be 0.");
+		assert(0);
+	}
+
+	// Safety check, the arenas have to hold at least one chunk each
+	const size_t arena_size = memory_buffer.size() / arena_count / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+	if (arena_size == 0u)
+	{
+		debug_print("ERROR [ConcurrentFreeListAllocator.cpp, ConcurrentFreeListAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Buffer size cannot be less than 64 bytes per arena.");
+		assert(0);
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+	m_arena_count = arena_count;
+	m_arena_size = arena_size;
+
+	// Small chunks come from the thread caches so the arenas mostly see batches and large chunks, best fit keeps them compact.
+	// The granularity keeps every payload MIN_ALIGNMENT aligned.
+	const size_t granularity = std::max(MIN_ALIGNMENT, FreeListAllocatorBase::CalculateGranularity(m_arena_size));
+	m_arenas = std::make_unique<Arena[]>(m_arena_count);
+	for (unsigned i = 0u; i < m_arena_count; i++)
+		m_arenas[i].m_allocator.Init(m_buffer.subspan(i * m_arena_size, m_arena_size), granularity);
+
+	// Spread the thread caches over the arenas
+	m_thread_caches = std::make_unique<ThreadCache[]>(MAX_THREAD_CACHES);
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES; i++)
+		m_thread_caches[i].m_arena = i % m_arena_count;
+
+	std::lock_guard<std::mutex> lock(s_live_allocators_mutex);
+	s_live_allocators.erase(m_id);
+	m_id = s_next_allocator_id++;
+	s_live_allocators[m_id] = this;
+}
+
+ConcurrentFreeListAllocator::ThreadCache* ConcurrentFreeListAllocator::GetThreadCache()
+{
+	if (t_allocator_id == m_id)
+		return &m_thread_caches[t_thread_cache];
+
+	// Look for the cache this thread already has, otherwise claim a free one
+	const std::thread::id this_thread = std::this_thread::get_id();
+	unsigned cache_index = MAX_THREAD_CACHES;
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES && cache_index == MAX_THREAD_CACHES; i++)
+		if (m_thread_caches[i].m_owner.load(std::memory_order_acquire) == this_thread)
+			cache_index = i;
+
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES && cache_index == MAX_THREAD_CACHES; i++)
+	{
+		std::thread::id no_owner{};
+		if (m_thread_caches[i].m_owner.compare_exchange_strong(no_owner, this_thread, std::memory_order_acquire))
+		{
+			cache_index = i;
+
+			// Flush and release it when the thread exits
+			if (std::find(t_exit_flush.m_allocator_ids.begin(), t_exit_flush.m_allocator_ids.end(), m_id) == t_exit_flush.m_allocator_ids.end())
+				t_exit_flush.m_allocator_ids.push_back(m_id);
+		}
+	}
+
+	if (cache_index == MAX_THREAD_CACHES)
+		return nullptr;
+
+	t_allocator_id = m_id;
+	t_thread_cache = cache_index;
+	return &m_thread_caches[cache_index];
+}
+
+unsigned ConcurrentFreeListAllocator::FindArena(const void* ptr) const
+{
+	if (ptr < m_buffer.data() || ptr >= m_buffer.data() + m_arena_size * m_arena_count)
+		return m_arena_count;
+
+	return static_cast<unsigned>((static_cast<const std::byte*>(ptr) - m_buffer.data()) / m_arena_size);
+}
+
+bool ConcurrentFreeListAllocator::IsChunkCached(const void* ptr) const
+{
+	// Every payload is MIN_ALIGNMENT aligned, other ptrs arent chunks and are left for the arena to report
+	if (reinterpret_cast<uintptr_t>(ptr) % MIN_ALIGNMENT != 0u || static_cast<const std::byte*>(ptr) + sizeof(CACHED_CHUNK_KEY) > m_buffer.data() + m_buffer.size())
+		return false;
+
+	return *static_cast<const uint64_t*>(ptr) == CACHED_CHUNK_KEY;
+}
+
+void ConcurrentFreeListAllocator::FlushPendingFrees(ThreadCache& cache)
+{
+	BasicFreeListAllocator<BestFitPolicy>& allocator = m_arenas[cache.m_arena].m_allocator;
+
+	// Recently freed chunks stay in the cache if their bin has room, the size class is rounded down so they can serve all of it
+	for (unsigned i = 0u; i < cache.m_pending_count; i++)
+	{
+		void* chunk = cache.m_pending[i];
+		const size_t size_in_bytes = allocator.GetAllocationSize(chunk);
+
+		// Not a valid chunk, GetAllocationSize already reported it. Chunks freed twice since the last flush are caught here too if the
+		// first free gave them back to the arena.
+		if (size_in_bytes == 0u)
+			continue;
+
+		// Freed twice since the last flush and the first free put it in a bin
+		if (IsChunkCached(chunk))
+		{
+			debug_print("ERROR [ConcurrentFreeListAllocator.cpp, ConcurrentFreeListAllocator, void FlushPendingFrees(ThreadCache&)]: Ptr to deallocate was already freed.");
+			continue;
+		}
+
+		const size_t size_class = size_in_bytes / SIZE_CLASS_GRANULARITY;
+		if (size_class != 0u && size_class <= SIZE_CLASS_COUNT && cache.m_bin_counts[size_class - 1u] < CACHE_CAPACITY)
+		{
+			SetChunkCached(chunk, true);
+			cache.m_bins[size_class - 1u][cache.m_bin_counts[size_class - 1u]++] = chunk;
+		}
+		else
+			allocator.Free(chunk);
+	}
+
+	cache.m_pending_count = 0u;
+}
+
+void* ConcurrentFreeListAllocator::AllocateFromArenas(const unsigned& size_in_bytes, const size_t& alignment, const unsigned& home_arena)
+{
+	// Start at the home arena and move on to the next one if it is full
+	for (unsigned i = 0u; i < m_arena_count; i++)
+	{
+		Arena& arena = m_arenas[(home_arena + i) % m_arena_count];
+
+		std::lock_guard<std::mutex> lock(arena.m_mutex);
+		if (void* chunk = arena.m_allocator.Allocate(size_in_bytes, alignment))
+			return chunk;
+	}
+
+	return nullptr;
+}
+
+void* ConcurrentFreeListAllocator::Allocate(unsigned size_in_bytes, const size_t& alignment)
+{
+	if (size_in_bytes == 0u)
+		return nullptr;
+
+	ThreadCache* cache = GetThreadCache();
+
+	// Chunks with a larger alignment than every chunk has and large chunks go straight to the arenas
+	if (cache == nullptr || alignment > MIN_ALIGNMENT || size_in_bytes > MAX_SMALL_SIZE)
+	{
+		const unsigned home_arena = cache != nullptr ? cache->m_arena : static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % m_arena_count);
+		return AllocateFromArenas(size_in_bytes, alignment > MIN_ALIGNMENT ? alignment : 0u, home_arena);
+	}
+
+	const unsigned size_class = GetSizeClass(size_in_bytes);
+	unsigned& bin_count = cache->m_bin_counts[size_class];
+	if (bin_count == 0u)
+	{
+		Arena& arena = m_arenas[cache->m_arena];
+		std::lock_guard<std::mutex> lock(arena.m_mutex);
+
+		// Recently freed chunks first, then new ones from the arena
+		FlushPendingFrees(*cache);
+		while (bin_count < CACHE_BATCH)
+		{
+			void* chunk = arena.m_allocator.Allocate((size_class + 1u) * SIZE_CLASS_GRANULARITY);
+			if (chunk == nullptr)
+				break;
+
+			SetChunkCached(chunk, true);
+			cache->m_bins[size_class][bin_count++] = chunk;
+		}
+	}
+
+	// The home arena is full, try the others
+	if (bin_count == 0u)
+		return AllocateFromArenas((size_class + 1u) * SIZE_CLASS_GRANULARITY, 0u, cache->m_arena + 1u);
+
+	void* chunk = cache->m_bins[size_class][--bin_count];
+	SetChunkCached(chunk, false);
+	return chunk;
+}
+
+void ConcurrentFreeListAllocator::Free(void* ptr)
+{
+	const unsigned arena_index = FindArena(ptr);
+	if (arena_index == m_arena_count)
+	{
+		debug_print("ERROR [ConcurrentFreeListAllocator.cpp, ConcurrentFreeListAllocator, void Free(void*)]: Ptr to deallocate was not in buffer.");
+		return;
+	}
+
+	// Its arena still sees a chunk in a bin as allocated, so this is checked before it can go back there from any thread
+	if (IsChunkCached(ptr))
+	{
+		debug_print("ERROR [ConcurrentFreeListAllocator.cpp, ConcurrentFreeListAllocator, void Free(void*)]: Ptr to deallocate was already freed.");
+		return;
+	}
+
+	// Only chunks of the home arena are cached, the rest go straight back to the arena they belong to
+	ThreadCache* cache = GetThreadCache();
+	if (cache == nullptr || cache->m_arena != arena_index)
+	{
+		Arena& arena = m_arenas[arena_index];
+		std::lock_guard<std::mutex> lock(arena.m_mutex);
+		arena.m_allocator.Free(ptr);
+		return;
+	}
+
+	// Checked against the arena when the pending frees are flushed
+	cache->m_pending[cache->m_pending_count++] = ptr;
+	if (cache->m_pending_count == PENDING_CAPACITY)
+	{
+		std::lock_guard<std::mutex> lock(m_arenas[arena_index].m_mutex);
+		FlushPendingFrees(*cache);
+	}
+}
+
+void ConcurrentFreeListAllocator::FlushThreadCache()
+{
+	ThreadCache* cache = GetThreadCache();
+	if (cache == nullptr)
+		return;
+
+	{
+		Arena& arena = m_arenas[cache->m_arena];
+		std::lock_guard<std::mutex> lock(arena.m_mutex);
+
+		FlushPendingFrees(*cache);
+		for (unsigned i = 0u; i < SIZE_CLASS_COUNT; i++)
+		{
+			for (unsigned j = 0u; j < cache->m_bin_counts[i]; j++)
+			{
+				SetChunkCached(cache->m_bins[i][j], false);
+				arena.m_allocator.Free(cache->m_bins[i][j]);
+			}
+
+			cache->m_bin_counts[i] = 0u;
+		}
+	}
+
+	cache->m_owner.store(std::thread::id{}, std::memory_order_release);
+	t_allocator_id = 0u;
+}
+
+void ConcurrentFreeListAllocator::Clear()
+{
+	// The threads keep their caches, only what was in them is gone. The keys would be left in the middle of the new free chunks.
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES; i++)
+	{
+		for (unsigned j = 0u; j < SIZE_CLASS_COUNT; j++)
+			for (unsigned k = 0u; k < m_thread_caches[i].m_bin_counts[j]; k++)
+				SetChunkCached(m_thread_caches[i].m_bins[j][k], false);
+
+		m_thread_caches[i].m_bin_counts.fill(0u);
+		m_thread_caches[i].m_pending_count = 0u;
+	}
+
+	for (unsigned i = 0u; i < m_arena_count; i++)
+		m_arenas[i].m_allocator.Clear();
+}
+
+FreeListAllocatorBase::FreeListStats ConcurrentFreeListAllocator::GetStats() const
+{
+	FreeListAllocatorBase::FreeListStats result{};
+	for (unsigned i = 0u; i < m_arena_count; i++)
+	{
+		std::lock_guard<std::mutex> lock(m_arenas[i].m_mutex);
+		const FreeListAllocatorBase::FreeListStats& stats = m_arenas[i].m_allocator.GetStats();
+
+		result.m_bytes_in_use += stats.m_bytes_in_use;
+		result.m_bytes_free += stats.m_bytes_free;
+		result.m_high_water_mark += stats.m_high_water_mark;
+		result.m_alloc_chunk_count += stats.m_alloc_chunk_count;
+		result.m_free_chunk_count += stats.m_free_chunk_count;
+		result.m_free_size_class_bitmap |= stats.m_free_size_class_bitmap;
+		for (unsigned j = 0u; j < FreeListAllocatorBase::FREE_SIZE_CLASS_COUNT; j++)
+			result.m_free_size_classes[j] += stats.m_free_size_classes[j];
+	}
+
+	return result;
+}
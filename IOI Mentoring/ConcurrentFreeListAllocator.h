@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ * @filename ConcurrentFreeListAllocator.h
+ * @brief	 Contains the thread safe free list allocator class header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "BasicFreeListAllocator.h"
+
+// The buffer is split into arenas, each one a free list allocator with its own lock, and every thread has a home arena.
+// Small allocations are served from a per thread cache of chunks of the home arena, the arena is only locked to refill or
+// flush the cache in batches. The arena a chunk belongs to is found from its address, so frees from other threads go back to it.
+class ConcurrentFreeListAllocator : public IAllocator
+{
+public:
+	// Small sizes are rounded up to a multiple of the granularity, one cache bin per multiple
+	static constexpr unsigned SIZE_CLASS_GRANULARITY = 16u;
+	static constexpr unsigned SIZE_CLASS_COUNT = 16u;
+	static constexpr unsigned MAX_SMALL_SIZE = SIZE_CLASS_GRANULARITY * SIZE_CLASS_COUNT;
+
+	static constexpr unsigned CACHE_CAPACITY = 32u;					// Chunks per size class per thread
+	static constexpr unsigned CACHE_BATCH = CACHE_CAPACITY / 2u;		// Chunks taken from the arena at once when a bin is empty
+	static constexpr unsigned PENDING_CAPACITY = 64u;				// Frees kept by a thread before locking the arena
+	static constexpr unsigned MAX_THREAD_CACHES = 64u;				// Threads after this one lock the arena on every call
+
+	// Every chunk is at least this aligned, like malloc. It is the arenas' granularity, so it cant be less than a free chunk.
+	static constexpr size_t MIN_ALIGNMENT = std::max<size_t>(alignof(std::max_align_t), FreeListAllocatorBase::MIN_FREE_CHUNK_SIZE);
+
+	ConcurrentFreeListAllocator() = default;
+	~ConcurrentFreeListAllocator();
+
+	ConcurrentFreeListAllocator(const ConcurrentFreeListAllocator&) = delete;
+	ConcurrentFreeListAllocator& operator=(const ConcurrentFreeListAllocator&) = delete;
+
+	// Not thread safe, nothing can be using the allocator while it is initialized
+	void Init(std::span<std::byte>&& memory_buffer, const unsigned& arena_count = std::max(1u, std::thread::hardware_concurrency()));
+
+	// Alignments up to MIN_ALIGNMENT are free, larger ones skip the thread cache
+	void* Allocate(unsigned size_in_bytes, const size_t& alignment = 0u);
+
+	void Free(void* ptr);
+
+	// Gives the calling thread's cached chunks back to the arena and releases its cache for other threads. Called on its own
+	// when a thread that claimed a cache exits, if the allocator is still alive.
+	void FlushThreadCache();
+
+	// Not thread safe, nothing can be using the allocator while it is cleared
+	void Clear();
+
+	size_t GetBufferSize() const
+	{
+		return m_buffer.size();
+	}
+
+	unsigned GetArenaCount() const
+	{
+		return m_arena_count;
+	}
+
+	// Sum of every arena's stats, chunks in the thread caches count as in use. The high-water mark is the sum of the arenas' ones.
+	FreeListAllocatorBase::FreeListStats GetStats() const;
+
+private:
+	struct alignas(64) Arena
+	{
+		std::mutex m_mutex;
+		BasicFreeListAllocator<BestFitPolicy> m_allocator;
+	};
+
+	// Only touched by the thread that owns it, m_owner is the only member other threads read
+	struct alignas(64) ThreadCache
+	{
+		std::atomic<std::thread::id> m_owner{};
+		unsigned m_arena = 0u;
+
+		// Payload ptrs of chunks of the home arena that are allocated as far as the arena knows
+		std::array<unsigned, SIZE_CLASS_COUNT> m_bin_counts{};
+		std::array<std::array<void*, CACHE_CAPACITY>, SIZE_CLASS_COUNT> m_bins{};
+
+		// Freed ptrs of the home arena, we dont know their size until we read their headers under the lock
+		unsigned m_pending_count = 0u;
+		std::array<void*, PENDING_CAPACITY> m_pending{};
+	};
+
+	ThreadCache* GetThreadCache();
+
+	// Chunks in the bins have this key at the start of their payload and lose it when they leave, so a chunk that is freed again while
+	// it sits in a bin is caught without locking its arena. Pending frees dont get it, they havent been checked against the arena yet.
+	static constexpr uint64_t CACHED_CHUNK_KEY = 0x9E3779B97F4A7C15u;
+
+	bool IsChunkCached(const void* ptr) const;
+
+	static void SetChunkCached(void* ptr, const bool& cached)
+	{
+		*static_cast<uint64_t*>(ptr) = cached ? CACHED_CHUNK_KEY : 0u;
+	}
+
+	// Index of the arena the ptr belongs to, m_arena_count if it isnt in any
+	unsigned FindArena(const void* ptr) const;
+
+	// Has to be called with the cache's arena locked
+	void FlushPendingFrees(ThreadCache& cache);
+
+	void* AllocateFromArenas(const unsigned& size_in_bytes, const size_t& alignment, const unsigned& home_arena);
+
+	static unsigned GetSizeClass(const unsigned& size_in_bytes)
+	{
+		return (size_in_bytes + SIZE_CLASS_GRANULARITY - 1u) / SIZE_CLASS_GRANULARITY - 1u;
+	}
+
+	std::unique_ptr<Arena[]> m_arenas;
+	std::unique_ptr<ThreadCache[]> m_thread_caches;
+	unsigned m_arena_count = 0u;
+	size_t m_arena_size = 0u;
+
+	unsigned m_id = 0u;			// Unique per Init, lets threads remember which cache is theirs
+	std::span<std::byte> m_buffer{};
+};
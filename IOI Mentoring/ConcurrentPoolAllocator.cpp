@@ -0,0 +1,212 @@
+/***************************************************************************//**
+ * @filename ConcurrentPoolAllocator.cpp
+ * @brief	 Contains the lock free pool allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "ConcurrentPoolAllocator.h"
+
+void ConcurrentPoolAllocator::Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes)
+{
+	if (memory_buffer.size() == 0)
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Buffer size cannot be zero.");
+		return;
+	}
+
+	if (chunk_size_in_bytes < sizeof(ConcurrentPoolAllocationHeader))
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Chunk size was less than header size (unsigned).");
+		return;
+	}
+
+	if (memory_buffer.size() % chunk_size_in_bytes != 0)
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Chunk size was not a multiple of buffer size.");
+		return;
+	}
+
+	if (memory_buffer.size() / chunk_size_in_bytes >= NULL_INDEX)
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Chunk count cannot be more than 2^32 - 2.");
+		return;
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+	m_chunk_size = chunk_size_in_bytes;
+	m_chunk_count = static_cast<unsigned>(m_buffer.size() / m_chunk_size);
+	m_occupancy_bitmap = std::make_unique<std::atomic<uint64_t>[]>((m_chunk_count + 63u) / 64u);
+
+	Clear();
+}
+
+void* ConcurrentPoolAllocator::Allocate()
+{
+	uint64_t head = m_free_list_head.load(std::memory_order_acquire);
+	unsigned chunk_index = NULL_INDEX;
+	do
+	{
+		chunk_index = static_cast<unsigned>(head);
+		if (chunk_index == NULL_INDEX)
+		{
+			debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void* Allocate()]: No free chunks to allocate into.");
+			return nullptr;
+		}
+
+		// NOTE: Another thread may pop this chunk and write to it before we get here, the next index we read is then garbage
+		// but the counter in the head has changed, so the compare exchange fails and we try again
+	} while (!m_free_list_head.compare_exchange_weak(head, MakeHead(head, std::atomic_ref<unsigned>(GetChunk(chunk_index)->m_free_list_next).load(std::memory_order_relaxed)),
+													 std::memory_order_acquire, std::memory_order_acquire));
+
+	m_occupancy_bitmap[chunk_index / 64u].fetch_or(uint64_t(1u) << (chunk_index % 64u), std::memory_order_relaxed);
+
+	// Return a ptr to the allocated memory
+	return GetChunk(chunk_index);
+}
+
+void ConcurrentPoolAllocator::Free(void* ptr)
+{
+	if (!IsChunkPtrValid(ptr))
+		return;
+
+	// Clearing the bit tells us if it was set, so of two threads freeing the same chunk only one gets to push it
+	const unsigned chunk_index = GetChunkIndex(ptr);
+	const uint64_t chunk_bit = uint64_t(1u) << (chunk_index % 64u);
+	if (!(m_occupancy_bitmap[chunk_index / 64u].fetch_and(~chunk_bit, std::memory_order_relaxed) & chunk_bit))
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void Free(void*)]: Ptr to deallocate was already free.");
+		return;
+	}
+
+	// Doesn't have to be sorted so we can just push the freed chunk at the start
+	uint64_t head = m_free_list_head.load(std::memory_order_relaxed);
+	do
+	{
+		std::atomic_ref<unsigned>(static_cast<ConcurrentPoolAllocationHeader*>(ptr)->m_free_list_next).store(static_cast<unsigned>(head), std::memory_order_relaxed);
+	} while (!m_free_list_head.compare_exchange_weak(head, MakeHead(head, chunk_index), std::memory_order_release, std::memory_order_relaxed));
+}
+
+unsigned ConcurrentPoolAllocator::AllocateN(std::span<void*> out)
+{
+	if (out.empty())
+		return 0u;
+
+	uint64_t head = m_free_list_head.load(std::memory_order_acquire);
+	unsigned count = 0u;
+	unsigned run_end = NULL_INDEX;
+	do
+	{
+		// Walk up to out.size() chunks from the head. Like in Allocate, the links we read may be garbage if another thread popped
+		// these chunks in the meantime, they are only used if the head hasnt changed, but they are range checked before following them.
+		count = 0u;
+		run_end = static_cast<unsigned>(head);
+		while (count < out.size() && run_end < m_chunk_count)
+		{
+			out[count++] = GetChunk(run_end);
+			run_end = std::atomic_ref<unsigned>(GetChunk(run_end)->m_free_list_next).load(std::memory_order_relaxed);
+		}
+
+		if (count == 0u)
+		{
+			debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, unsigned AllocateN(std::span<void*>)]: No free chunks to allocate into.");
+			return 0u;
+		}
+	} while (!m_free_list_head.compare_exchange_weak(head, MakeHead(head, run_end), std::memory_order_acquire, std::memory_order_acquire));
+
+	for (unsigned i = 0u; i < count; i++)
+	{
+		const unsigned chunk_index = GetChunkIndex(out[i]);
+		m_occupancy_bitmap[chunk_index / 64u].fetch_or(uint64_t(1u) << (chunk_index % 64u), std::memory_order_relaxed);
+	}
+
+	return count;
+}
+
+void ConcurrentPoolAllocator::FreeN(std::span<void* const> ptrs)
+{
+	// Link the chunks we get to free to each other, the first one will be linked to the head once we know it
+	ConcurrentPoolAllocationHeader* run_tail = nullptr;
+	unsigned run_head = NULL_INDEX;
+	for (void* ptr : ptrs)
+	{
+		if (!IsChunkPtrValid(ptr))
+			continue;
+
+		const unsigned chunk_index = GetChunkIndex(ptr);
+		const uint64_t chunk_bit = uint64_t(1u) << (chunk_index % 64u);
+		if (!(m_occupancy_bitmap[chunk_index / 64u].fetch_and(~chunk_bit, std::memory_order_relaxed) & chunk_bit))
+		{
+			debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, void FreeN(std::span<void* const>)]: Ptr to deallocate was already free.");
+			continue;
+		}
+
+		if (run_tail == nullptr)
+			run_tail = static_cast<ConcurrentPoolAllocationHeader*>(ptr);
+		else
+			std::atomic_ref<unsigned>(static_cast<ConcurrentPoolAllocationHeader*>(ptr)->m_free_list_next).store(run_head, std::memory_order_relaxed);
+		run_head = chunk_index;
+	}
+
+	if (run_tail == nullptr)
+		return;
+
+	uint64_t head = m_free_list_head.load(std::memory_order_relaxed);
+	do
+	{
+		std::atomic_ref<unsigned>(run_tail->m_free_list_next).store(static_cast<unsigned>(head), std::memory_order_relaxed);
+	} while (!m_free_list_head.compare_exchange_weak(head, MakeHead(head, run_head), std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool ConcurrentPoolAllocator::IsChunkFree(void* ptr) const
+{
+	if (!IsChunkPtrValid(ptr))
+		return true;
+
+	const unsigned chunk_index = GetChunkIndex(ptr);
+	return !(m_occupancy_bitmap[chunk_index / 64u].load(std::memory_order_relaxed) & (uint64_t(1u) << (chunk_index % 64u)));
+}
+
+bool ConcurrentPoolAllocator::IsChunkPtrValid(void* ptr) const
+{
+	if (ptr == nullptr)
+		return false;
+
+	// Check if the ptr is pointing somewhere inside the buffer
+	if (ptr < m_buffer.data() || ptr >= m_buffer.data() + GetBufferSize())
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, bool IsChunkPtrValid(void*)]: Ptr to deallocate was not in buffer.");
+		return false;
+	}
+
+	// Check if the ptr points to the start of a chunk
+	if ((static_cast<std::byte*>(ptr) - m_buffer.data()) % m_chunk_size != 0)
+	{
+		debug_print("ERROR [ConcurrentPoolAllocator.cpp, ConcurrentPoolAllocator, bool IsChunkPtrValid(void*)]: Ptr to deallocate was not aligned with chunks.");
+		return false;
+	}
+
+	return true;
+}
+
+unsigned ConcurrentPoolAllocator::GetFreeChunkAmount() const
+{
+	unsigned allocated_chunk_count = 0u;
+	for (unsigned i = 0u; i < (m_chunk_count + 63u) / 64u; i++)
+		allocated_chunk_count += std::popcount(m_occupancy_bitmap[i].load(std::memory_order_relaxed));
+
+	return m_chunk_count - allocated_chunk_count;
+}
+
+void ConcurrentPoolAllocator::Clear()
+{
+	// Write header info for each chunk, every chunk links to the one after it
+	for (unsigned i = 0u; i < m_chunk_count; i++)
+		new (GetChunk(i)) ConcurrentPoolAllocationHeader(i + 1u < m_chunk_count ? i + 1u : NULL_INDEX);
+
+	for (unsigned i = 0u; i < (m_chunk_count + 63u) / 64u; i++)
+		m_occupancy_bitmap[i].store(0u, std::memory_order_relaxed);
+
+	m_free_list_head.store(MakeHead(m_free_list_head.load(std::memory_order_relaxed), m_chunk_count != 0u ? 0u : NULL_INDEX), std::memory_order_release);
+}
@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @filename ConcurrentPoolAllocator.h
+ * @brief	 Contains the lock free pool allocator class header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+
+// Pool allocator that can be used from any number of threads without a lock. The free list is a Treiber stack: the head is the
+// index of the first free chunk packed with a counter that changes on every push and pop, so a compare exchange with a head that was
+// popped and pushed back in between (ABA) fails. The occupancy bitmap is atomic too, so double frees are still caught.
+class ConcurrentPoolAllocator : public IAllocator
+{
+public:
+	struct ConcurrentPoolAllocationHeader
+	{
+		ConcurrentPoolAllocationHeader(const unsigned& free_list_next = NULL_INDEX) : m_free_list_next(free_list_next)
+		{	};
+
+		unsigned m_free_list_next = NULL_INDEX;		// Index of the next free chunk
+	};
+
+	static constexpr unsigned NULL_INDEX = ~0u;
+
+	ConcurrentPoolAllocator() = default;
+
+	ConcurrentPoolAllocator(const ConcurrentPoolAllocator&) = delete;
+	ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&) = delete;
+
+	// Not thread safe, nothing can be using the allocator while it is initialized
+	void Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes);
+
+	void* Allocate();
+
+	void Free(void* ptr);
+
+	// Fills out with up to its size chunks and returns how many. The whole run is popped with a single compare exchange, so it is
+	// one synchronisation for the batch instead of one per chunk.
+	unsigned AllocateN(std::span<void*> out);
+
+	// Frees every chunk in ptrs, invalid ones and double frees are skipped. They are linked to each other and pushed with a single
+	// compare exchange.
+	void FreeN(std::span<void* const> ptrs);
+
+	// Invalid ptrs count as free so they are never freed
+	bool IsChunkFree(void* ptr) const;
+
+	bool IsChunkPtrValid(void* ptr) const;
+
+	// Not thread safe, nothing can be using the allocator while it is cleared
+	void Clear();
+
+	size_t GetBufferSize() const
+	{
+		return m_buffer.size();
+	}
+
+	size_t GetChunkSize() const
+	{
+		return m_chunk_size;
+	}
+
+	// Counts the clear bits of the occupancy bitmap, only exact while no other thread is allocating or freeing
+	unsigned GetFreeChunkAmount() const;
+
+private:
+	unsigned GetChunkIndex(const void* ptr) const
+	{
+		return static_cast<unsigned>((static_cast<const std::byte*>(ptr) - m_buffer.data()) / m_chunk_size);
+	}
+
+	ConcurrentPoolAllocationHeader* GetChunk(const unsigned& chunk_index) const
+	{
+		return reinterpret_cast<ConcurrentPoolAllocationHeader*>(m_buffer.data() + static_cast<size_t>(chunk_index) * m_chunk_size);
+	}
+
+	// The top 32 bits of the head are the ABA counter, the bottom ones the index of the first free chunk
+	static uint64_t MakeHead(const uint64_t& prev_head, const unsigned& chunk_index)
+	{
+		return ((prev_head >> 32) + 1u) << 32 | chunk_index;
+	}
+
+	std::span<std::byte> m_buffer{};
+	unsigned m_chunk_size = 0u;
+	unsigned m_chunk_count = 0u;
+
+	alignas(64) std::atomic<uint64_t> m_free_list_head{ NULL_INDEX };
+
+	// One bit per chunk, set while it is allocated
+	std::unique_ptr<std::atomic<uint64_t>[]> m_occupancy_bitmap;
+};
@@ -0,0 +1,140 @@
+/***************************************************************************//**
+ * @filename FrameArena.cpp
+ * @brief	 Contains the auto resetting frame arena and the N-buffered frame
+ *			 arena class function implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "FrameArena.h"
+
+void FrameArena::Init(std::span<std::byte>&& memory_buffer)
+{
+	if (memory_buffer.size() == 0)
+	{
+		debug_print("ERROR [FrameArena.cpp, FrameArena, void Init(std::span<std::byte>&&)]: Buffer size cannot be zero.");
+		return;
+	}
+
+	m_linear.Init(std::forward<std::span<std::byte>>(memory_buffer));
+
+	Clear();
+}
+
+void* FrameArena::Allocate(size_t size_in_bytes, const size_t& alignment)
+{
+	void* ptr = m_linear.Allocate(size_in_bytes, alignment);
+
+	// The linear allocator already reported the failure
+	if (ptr != nullptr)
+		m_live_ptrs.push_back(ptr);
+
+	return ptr;
+}
+
+void FrameArena::Free(void* ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	if (!m_linear.IsPtrAllocated(ptr))
+	{
+		debug_print("ERROR [FrameArena.cpp, FrameArena, void Free(void*)]: Ptr to deallocate was not allocated from this arena.");
+		return;
+	}
+
+	if (m_live_ptrs.empty())
+	{
+		debug_print("ERROR [FrameArena.cpp, FrameArena, void Free(void*)]: More frees than allocations.");
+		return;
+	}
+
+	// Allocated, freed already or before the arena was last rewound
+	auto live = std::lower_bound(m_live_ptrs.begin(), m_live_ptrs.end(), ptr);
+	if (live == m_live_ptrs.end() || *live != ptr)
+	{
+		debug_print("ERROR [FrameArena.cpp, FrameArena, void Free(void*)]: Ptr to deallocate was freed already or allocated before the arena was rewound.");
+		return;
+	}
+
+	m_live_ptrs.erase(live);
+
+	// Last allocation gone, the whole buffer is free again
+	if (m_live_ptrs.empty())
+		m_linear.Clear();
+}
+
+void FrameArena::Clear()
+{
+	m_linear.Clear();
+	m_live_ptrs.clear();
+}
+
+void BufferedFrameArena::Init(std::span<std::byte>&& memory_buffer, const unsigned& frame_count)
+{
+	if (frame_count == 0u || frame_count > MAX_FRAME_COUNT)
+	{
+		debug_print("ERROR [FrameArena.cpp, BufferedFrameArena, void Init(std::span<std::byte>&&, const unsigned&)]: Frame count has to be between 1 and 8.");
+		return;
+	}
+
+	const size_t frame_size = memory_buffer.size() / frame_count;
+	if (frame_size == 0u)
+	{
+		debug_print("ERROR [FrameArena.cpp, BufferedFrameArena, void Init(std::span<std::byte>&&, const unsigned&)]: Buffer is too small for the frame count.");
+		return;
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+	m_frame_count = frame_count;
+	m_frame_size = frame_size;
+	m_current_frame = 0u;
+
+	for (unsigned i = 0u; i < m_frame_count; i++)
+		m_frames[i].Init(m_buffer.subspan(i * m_frame_size, m_frame_size));
+}
+
+void* BufferedFrameArena::Allocate(size_t size_in_bytes, const size_t& alignment)
+{
+	if (m_frame_count == 0u)
+	{
+		debug_print("ERROR [FrameArena.cpp, BufferedFrameArena, void* Allocate(size_t, const size_t&)]: Arena was not initialized.");
+		return nullptr;
+	}
+
+	return m_frames[m_current_frame].Allocate(size_in_bytes, alignment);
+}
+
+void BufferedFrameArena::Free(void* ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	const unsigned frame = GetFrameIndex(ptr);
+	if (frame == m_frame_count)
+	{
+		debug_print("ERROR [FrameArena.cpp, BufferedFrameArena, void Free(void*)]: Ptr to deallocate was not in buffer.");
+		return;
+	}
+
+	m_frames[frame].Free(ptr);
+}
+
+void BufferedFrameArena::NextFrame()
+{
+	if (m_frame_count == 0u)
+		return;
+
+	m_current_frame = (m_current_frame + 1u) % m_frame_count;
+
+	// The frame being reused was last allocated from N - 1 frames ago, all of it can go at once
+	m_frames[m_current_frame].Clear();
+}
+
+void BufferedFrameArena::Clear()
+{
+	for (unsigned i = 0u; i < m_frame_count; i++)
+		m_frames[i].Clear();
+
+	m_current_frame = 0u;
+}
@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @filename FrameArena.h
+ * @brief	 Contains the auto resetting frame arena and the N-buffered frame
+ *			 arena class headers.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "LinearAllocator.h"
+
+// Linear allocator that keeps its live allocations and rewinds to the start of the buffer once the last one is freed, so a request
+// or frame that frees everything it allocated doesnt need a Clear. Only the start of every allocation is kept, so a ptr freed twice
+// or one from before the last rewind (a stale free from a recycled frame) is rejected, unless it happens to be the start of an
+// allocation made after the rewind.
+class FrameArena : public IAllocator
+{
+public:
+	void Init(std::span<std::byte>&& memory_buffer);
+
+	void* Allocate(size_t size_in_bytes, const size_t& alignment = 0u);
+
+	// Rewinds the whole arena when no allocations are left
+	void Free(void* ptr);
+
+	void Clear();
+
+	size_t GetOffset() const
+	{
+		return m_linear.GetOffset();
+	}
+
+	size_t GetBufferSize() const
+	{
+		return m_linear.GetBufferSize();
+	}
+
+	unsigned GetLiveAllocationCount() const
+	{
+		return static_cast<unsigned>(m_live_ptrs.size());
+	}
+
+	// O(log n), ptr is the start of a live allocation
+	bool IsAllocationLive(const void* ptr) const
+	{
+		return std::binary_search(m_live_ptrs.begin(), m_live_ptrs.end(), ptr);
+	}
+
+	bool IsPtrAllocated(const void* ptr) const
+	{
+		return m_linear.IsPtrAllocated(ptr);
+	}
+
+private:
+	LinearAllocator m_linear;
+	std::vector<const void*> m_live_ptrs;		// Sorted, allocations are made at increasing addresses until the arena rewinds
+};
+
+// Buffer split into N frame arenas that are used in turns. Allocations go to the current frame and NextFrame moves to the next one,
+// rewinding it, so anything allocated in a frame stays valid for the following N - 1 frames and is never freed one by one.
+class BufferedFrameArena : public IAllocator
+{
+public:
+	static constexpr unsigned MAX_FRAME_COUNT = 8u;
+
+	// The buffer is split in frame_count equal frames
+	void Init(std::span<std::byte>&& memory_buffer, const unsigned& frame_count = 2u);
+
+	void* Allocate(size_t size_in_bytes, const size_t& alignment = 0u);
+
+	// Frees from whichever frame the ptr belongs to, not only the current one. Ptrs from a frame that has been rewound since are
+	// rejected (see FrameArena).
+	void Free(void* ptr);
+
+	// Rotates to the next frame and rewinds it, dropping whatever was still allocated in it
+	void NextFrame();
+
+	void Clear();
+
+	unsigned GetFrameCount() const
+	{
+		return m_frame_count;
+	}
+
+	unsigned GetCurrentFrame() const
+	{
+		return m_current_frame;
+	}
+
+	size_t GetFrameSize() const
+	{
+		return m_frame_size;
+	}
+
+	const FrameArena& GetFrame(const unsigned& frame) const
+	{
+		return m_frames[frame];
+	}
+
+private:
+	// Frame the ptr is in, m_frame_count if it isnt in the buffer
+	unsigned GetFrameIndex(const void* ptr) const
+	{
+		if (ptr < m_buffer.data() || ptr >= m_buffer.data() + m_frame_size * m_frame_count)
+			return m_frame_count;
+
+		return static_cast<unsigned>(static_cast<size_t>(static_cast<const std::byte*>(ptr) - m_buffer.data()) / m_frame_size);
+	}
+
+	std::array<FrameArena, MAX_FRAME_COUNT> m_frames;
+	unsigned m_frame_count = 0u;
+	unsigned m_current_frame = 0u;
+	size_t m_frame_size = 0u;
+
+	std::span<std::byte> m_buffer{};
+};
@@ -0,0 +1,211 @@
+/***************************************************************************//**
+ * @filename FreeListAllocatorBase.cpp
+ * @brief	 Contains the free list allocator base class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "FreeListAllocatorBase.h"
+
+size_t FreeListAllocatorBase::CalculateGranularity(const size_t& buffer_size)
+{
+	if (buffer_size < SIZE_ALLOC_HEADER || buffer_size - SIZE_ALLOC_HEADER <= SIZE_MASK)
+		return 1u;
+
+	size_t granularity = MIN_FREE_CHUNK_SIZE;
+	while (buffer_size / granularity > SIZE_MASK)
+		granularity *= 2u;
+
+	return granularity;
+}
+
+bool FreeListAllocatorBase::InitBuffer(std::span<std::byte>&& memory_buffer, const size_t& granularity)
+{
+	// Granules have to be able to hold a free chunk, and be a power of two so the sizes can be shifted
+	if (granularity != 1u && (granularity < MIN_FREE_CHUNK_SIZE || !std::has_single_bit(granularity)))
+	{
+		debug_print("ERROR [FreeListAllocatorBase.cpp, FreeListAllocatorBase, bool InitBuffer(std::span<std::byte>&&, const size_t&)]: Granularity has to be 1 or a power of two of at least 16 bytes.");
+		return false;
+	}
+
+	m_granule_shift = static_cast<unsigned>(std::countr_zero(granularity));
+	m_size_bias = granularity != 1u ? SIZE_ALLOC_HEADER : 0u;
+
+	// The first alloc header goes right before a granule boundary and the chunks take whole granules, whatever is left at
+	// either end of the buffer is not used
+	if (granularity != 1u)
+	{
+		const size_t leading_bytes = (granularity - (reinterpret_cast<uintptr_t>(memory_buffer.data()) + SIZE_ALLOC_HEADER) % granularity) % granularity;
+		memory_buffer = leading_bytes < memory_buffer.size() ? memory_buffer.subspan(leading_bytes, (memory_buffer.size() - leading_bytes) & ~(granularity - 1u)) : std::span<std::byte>{};
+	}
+
+	// Safety check, buffer size cant be less than a free chunk
+	if (memory_buffer.size() < MIN_FREE_CHUNK_SIZE)
+	{
+		debug_print("ERROR [FreeListAllocatorBase.cpp, FreeListAllocatorBase, bool InitBuffer(std::span<std::byte>&&, const size_t&)]: Buffer size cannot be less than a free chunk (16 bytes, or a granule).");
+		return false;
+	}
+
+	// The top bits of the chunk sizes are used as boundary tags
+	if (memory_buffer.size() - SIZE_ALLOC_HEADER > GetMaxChunkSize())
+	{
+		debug_print("ERROR [FreeListAllocatorBase.cpp, FreeListAllocatorBase, bool InitBuffer(std::span<std::byte>&&, const size_t&)]: Buffer size cannot be larger than 1 GiB times the granularity.");
+		return false;
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+	return true;
+}
+
+unsigned FreeListAllocatorBase::CalculateAlignmentPadding(const FreeListFreeHeader* free_chunk, const size_t& alignment)
+{
+	if (alignment == 0u)
+		return 0u;
+
+	const uintptr_t payload_address = reinterpret_cast<uintptr_t>(free_chunk) + SIZE_ALLOC_HEADER;
+	size_t padding = (alignment - payload_address % alignment) % alignment;
+
+	// The padding needs room for the align tag, keep adding alignment until it has it
+	while (padding != 0u && padding < sizeof(ALIGN_TAG))
+		padding += alignment;
+
+	return static_cast<unsigned>(padding);
+}
+
+FreeListAllocatorBase::FreeListAllocHeader* FreeListAllocatorBase::GetNextChunk(const void* chunk) const
+{
+	return GetNextChunk(m_buffer, chunk, m_granule_shift, m_size_bias);
+}
+
+FreeListAllocatorBase::FreeListAllocHeader* FreeListAllocatorBase::GetNextChunk(const std::span<std::byte>& buffer, const void* chunk, const unsigned& granule_shift, const unsigned& size_bias)
+{
+	const std::byte* next = static_cast<const std::byte*>(chunk) + SIZE_ALLOC_HEADER + DecodeChunkSize(static_cast<const FreeListAllocHeader*>(chunk)->m_chunk_size, granule_shift, size_bias);
+	return next < buffer.data() + buffer.size() ? reinterpret_cast<FreeListAllocHeader*>(const_cast<std::byte*>(next)) : nullptr;
+}
+
+FreeListAllocatorBase::FreeListAllocHeader* FreeListAllocatorBase::GetAllocHeader(void* ptr) const
+{
+	// Move the ptr to the start of the alloc chunk, make it point to the header
+	ptr = static_cast<std::byte*>(ptr) - SIZE_ALLOC_HEADER;
+
+	// Aligned allocations may have an align tag in front of them instead, it tells us how far back the header is
+	if (ptr >= m_buffer.data() && static_cast<std::byte*>(ptr) + sizeof(ALIGN_TAG) <= m_buffer.data() + m_buffer.size())
+	{
+		const unsigned align_tag = *static_cast<unsigned*>(ptr);
+		if ((align_tag & ~SIZE_MASK) == ALIGN_TAG && static_cast<std::byte*>(ptr) - m_buffer.data() >= (align_tag & SIZE_MASK))
+			ptr = static_cast<std::byte*>(ptr) - (align_tag & SIZE_MASK);
+	}
+
+	// Check the ptr's validity, the boundary tags tell us everything else so there is no need to look through the free list
+	return IsChunkPtrValid(ptr) ? static_cast<FreeListAllocHeader*>(ptr) : nullptr;
+}
+
+size_t FreeListAllocatorBase::GetAllocationSize(void* ptr) const
+{
+	const FreeListAllocHeader* alloc_chunk = GetAllocHeader(ptr);
+	if (alloc_chunk == nullptr)
+		return 0u;
+
+	// The padding of aligned allocations is part of the chunk but not of the payload
+	return GetChunkSize(alloc_chunk) - (static_cast<std::byte*>(ptr) - reinterpret_cast<const std::byte*>(alloc_chunk) - SIZE_ALLOC_HEADER);
+}
+
+// Check if the ptr points outside the buffer, doesnt point to an allocated chunk or is nullptr
+bool FreeListAllocatorBase::IsChunkPtrValid(void* ptr) const
+{
+	return IsAllocChunkValid(m_buffer, ptr, m_granule_shift, m_size_bias);
+}
+
+bool FreeListAllocatorBase::IsAllocChunkValid(const std::span<std::byte>& buffer, const void* chunk, const unsigned& granule_shift, const unsigned& size_bias)
+{
+	// Safety check
+	if (chunk == nullptr)
+		return false;
+
+	const std::byte* chunk_start = static_cast<const std::byte*>(chunk);
+	const std::byte* buffer_end = buffer.data() + buffer.size();
+
+	// Check if the ptr is pointing somewhere inside the buffer
+	if (chunk_start < buffer.data() || chunk_start + SIZE_ALLOC_HEADER > buffer_end)
+	{
+		debug_print("ERROR [FreeListAllocatorBase.cpp, FreeListAllocatorBase, bool IsAllocChunkValid(const std::span<std::byte>&, const void*, const unsigned&, const unsigned&)]: Ptr to deallocate was not in buffer.");
+		return false;
+	}
+
+	// NOTE: We only have the boundary tags to go by, not a walk of the chunks. A ptr into a payload whose bytes happen to look like an
+	// alloc header with neighbours that agree with it still gets through, the checks below catch double frees and most garbage headers.
+	const unsigned chunk_header = static_cast<const FreeListAllocHeader*>(chunk)->m_chunk_size;
+	if (!(chunk_header & FLAG_IN_USE))
+	{
+		debug_print("ERROR [FreeListAllocatorBase.cpp, FreeListAllocatorBase, bool IsAllocChunkValid(const std::span<std::byte>&, const void*, const unsigned&, const unsigned&)]: Ptr to deallocate was not allocated.");
+		return false;
+	}
+
+	// Alloc headers are always at the start of a granule, and the chunk ends at the end of the buffer or right before a whole header
+	const size_t chunk_offset = static_cast<size_t>(chunk_start - buffer.data());
+	const size_t chunk_size = DecodeChunkSize(chunk_header, granule_shift, size_bias);
+	const size_t chunk_end = chunk_offset + SIZE_ALLOC_HEADER + chunk_size;
+	bool valid = (chunk_offset & ((size_t(1u) << granule_shift) - 1u)) == 0u && chunk_size <= buffer.size() &&
+				 (chunk_end == buffer.size() || chunk_end + SIZE_ALLOC_HEADER <= buffer.size());
+
+	// The next chunk's tag has to say we arent free
+	if (valid && chunk_end != buffer.size())
+		valid = !(reinterpret_cast<const FreeListAllocHeader*>(buffer.data() + chunk_end)->m_chunk_size & FLAG_PREV_FREE);
+
+	// A free previous chunk has its footer right before us and a free header with the same size where the footer says it starts
+	if (valid && (chunk_header & FLAG_PREV_FREE))
+	{
+		valid = chunk_offset >= MIN_FREE_CHUNK_SIZE;
+		if (valid)
+		{
+			const unsigned footer = reinterpret_cast<const FreeListFreeFooter*>(chunk_start - SIZE_FREE_FOOTER)->m_chunk_size;
+			const size_t prev_chunk_size = DecodeChunkSize(footer, granule_shift, size_bias);
+			valid = footer != 0u && footer <= SIZE_MASK && prev_chunk_size + SIZE_ALLOC_HEADER <= chunk_offset &&
+					reinterpret_cast<const FreeListAllocHeader*>(chunk_start - SIZE_ALLOC_HEADER - prev_chunk_size)->m_chunk_size == footer;
+		}
+	}
+
+	if (!valid)
+	{
+		debug_print("ERROR [FreeListAllocatorBase.cpp, FreeListAllocatorBase, bool IsAllocChunkValid(const std::span<std::byte>&, const void*, const unsigned&, const unsigned&)]: Ptr to deallocate was not aligned with an alloc chunk.");
+		return false;
+	}
+
+	return true;
+}
+
+std::list<FreeListAllocatorBase::FreeListFreeHeader*> FreeListAllocatorBase::GetFreeChunks() const
+{
+	std::list<FreeListFreeHeader*> result;
+	ForEachFreeChunk([&result](FreeListFreeHeader* chunk) { result.push_back(chunk); });
+
+	return result;
+}
+
+void FreeListAllocatorBase::AddFreeChunkStats(const size_t& chunk_size)
+{
+	const unsigned size_class = static_cast<unsigned>(std::bit_width(chunk_size)) - 1u;
+
+	m_stats.m_bytes_free += chunk_size;
+	m_stats.m_free_chunk_count++;
+	m_stats.m_free_size_classes[size_class]++;
+	m_stats.m_free_size_class_bitmap |= uint64_t(1u) << size_class;
+}
+
+void FreeListAllocatorBase::RemoveFreeChunkStats(const size_t& chunk_size)
+{
+	const unsigned size_class = static_cast<unsigned>(std::bit_width(chunk_size)) - 1u;
+
+	m_stats.m_bytes_free -= chunk_size;
+	m_stats.m_free_chunk_count--;
+	if (--m_stats.m_free_size_classes[size_class] == 0u)
+		m_stats.m_free_size_class_bitmap &= ~(uint64_t(1u) << size_class);
+}
+
+// Every chunk is a header plus its size, so whatever isnt free or a header is in use
+void FreeListAllocatorBase::UpdateInUseStats()
+{
+	m_stats.m_bytes_in_use = m_buffer.size() - m_stats.m_bytes_free - (m_stats.m_free_chunk_count + m_stats.m_alloc_chunk_count) * SIZE_ALLOC_HEADER;
+	m_stats.m_high_water_mark = std::max(m_stats.m_high_water_mark, m_stats.m_bytes_in_use);
+}
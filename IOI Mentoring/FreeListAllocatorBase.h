@@ -0,0 +1,231 @@
+/***************************************************************************//**
+ * @filename FreeListAllocatorBase.h
+ * @brief	 Contains the free list allocator base class header, the chunk
+ *			 layout and everything that doesnt depend on the allocation policy.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+
+class FreeListAllocatorBase : public IAllocator
+{
+public:
+	// Offsets are distances from the start of the buffer in granules, a 32-bit offset keeps the free header + footer at 16 bytes with
+	// two links. A free chunk is either in the free list or in the size tree (best fit), so both share the same two links.
+	struct FreeListFreeHeader
+	{
+		FreeListFreeHeader(const unsigned& chunk_size = 0u, const unsigned& free_list_next = NULL_OFFSET, const unsigned& free_list_prev = NULL_OFFSET) :
+			m_chunk_size(chunk_size), m_free_list_next(free_list_next), m_free_list_prev(free_list_prev)
+		{	}
+
+		FreeListFreeHeader(const FreeListFreeHeader& flfh)
+		{
+			m_chunk_size = flfh.m_chunk_size;
+			m_free_list_next = flfh.m_free_list_next;
+			m_free_list_prev = flfh.m_free_list_prev;
+		}
+
+		bool operator==(const FreeListFreeHeader& other)
+		{
+			return m_free_list_next == other.m_free_list_next && m_free_list_prev == other.m_free_list_prev && m_chunk_size == other.m_chunk_size;
+		}
+
+		unsigned m_chunk_size = 0u;				// Has to be the first member, it overlaps FreeListAllocHeader::m_chunk_size
+		union
+		{
+			unsigned m_free_list_next = NULL_OFFSET;
+			unsigned m_size_tree_left;
+		};
+		union
+		{
+			unsigned m_free_list_prev = NULL_OFFSET;
+			unsigned m_size_tree_right;
+		};
+	};
+
+	// Written at the end of each free chunk so the next chunk can find the start of its previous neighbour
+	struct FreeListFreeFooter
+	{
+		FreeListFreeFooter(const unsigned& chunk_size = 0u) : m_chunk_size(chunk_size)
+		{	}
+
+		unsigned m_chunk_size = 0u;
+	};
+
+	// The top bits of m_chunk_size are the boundary tags, free chunks never have any flag set
+	struct FreeListAllocHeader
+	{
+		FreeListAllocHeader(const unsigned& chunk_size = 0u) : m_chunk_size(chunk_size)
+		{	};
+
+		unsigned m_chunk_size = 0u;
+	};
+
+	static constexpr unsigned NULL_OFFSET = ~0u;
+
+	static constexpr unsigned FLAG_IN_USE = 1u << 31;
+	static constexpr unsigned FLAG_PREV_FREE = 1u << 30;
+	static constexpr unsigned SIZE_MASK = FLAG_PREV_FREE - 1u;
+
+	// Written right before the payload of aligned allocations when there is padding between it and the alloc header, the low
+	// bits are the padding. Free chunks never have flags and alloc headers always have FLAG_IN_USE so it cant be mistaken for either.
+	static constexpr unsigned ALIGN_TAG = FLAG_PREV_FREE;
+
+	static constexpr unsigned SIZE_ALLOC_HEADER = sizeof(FreeListAllocHeader);
+	static constexpr unsigned SIZE_FREE_HEADER = sizeof(FreeListFreeHeader);
+	static constexpr unsigned SIZE_FREE_FOOTER = sizeof(FreeListFreeFooter);
+
+	// Smallest chunk (headers included) that can be labelled as free
+	static constexpr unsigned MIN_FREE_CHUNK_SIZE = SIZE_FREE_HEADER + SIZE_FREE_FOOTER;
+
+	// Free chunks are counted by power of two size class, class i has the chunks with a size in [2^i, 2^(i+1))
+	static constexpr unsigned FREE_SIZE_CLASS_COUNT = 64u;
+
+	// Kept up to date by every allocation and free, so reading it is O(1). Sizes dont include the alloc headers.
+	struct FreeListStats
+	{
+		size_t m_bytes_in_use = 0u;			// Allocated chunk sizes, alignment padding and absorbed leftovers included
+		size_t m_bytes_free = 0u;
+		size_t m_high_water_mark = 0u;		// Most bytes in use since the last Clear
+		unsigned m_alloc_chunk_count = 0u;
+		unsigned m_free_chunk_count = 0u;
+		uint64_t m_free_size_class_bitmap = 0u;		// Bit i is set if m_free_size_classes[i] isnt 0
+		std::array<unsigned, FREE_SIZE_CLASS_COUNT> m_free_size_classes{};
+	};
+
+	// Smallest granularity that lets the whole buffer be a single chunk: 1 (plain byte sizes) for buffers of up to 1 GiB, and the
+	// smallest power of two from 16 bytes up for larger ones
+	static size_t CalculateGranularity(const size_t& buffer_size);
+
+	bool IsChunkPtrValid(void* ptr) const;
+
+	// Usable bytes of the allocated chunk the payload ptr belongs to, can be more than what was asked for. 0 if ptr isnt valid.
+	size_t GetAllocationSize(void* ptr) const;
+
+	size_t GetBufferSize() const
+	{
+		return m_buffer.size();
+	}
+
+	// For debug & test purposes, walks the whole buffer so the chunks are in address order and not in free list order
+	std::list<FreeListFreeHeader*> GetFreeChunks() const;
+
+	// Calls fn with every free chunk in address order, it walks the whole buffer but doesnt allocate
+	template <typename Fn>
+	void ForEachFreeChunk(Fn&& fn) const
+	{
+		for (std::byte* it = m_buffer.data(); it != nullptr; it = reinterpret_cast<std::byte*>(GetNextChunk(it)))
+			if (!(reinterpret_cast<FreeListAllocHeader*>(it)->m_chunk_size & FLAG_IN_USE))
+				fn(reinterpret_cast<FreeListFreeHeader*>(it));
+	}
+
+	const FreeListStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+	// The largest free chunk is in the highest size class with chunks, so it is at least this big (and less than twice as big).
+	// Any allocation (without alignment) of up to this size will succeed.
+	size_t GetLargestFreeChunkLowerBound() const
+	{
+		return m_stats.m_free_size_class_bitmap != 0u ? size_t(1u) << (std::bit_width(m_stats.m_free_size_class_bitmap) - 1) : 0u;
+	}
+
+	// For debug & benchmark purposes, amount of free chunks looked at by the allocation searches since the last Clear
+	size_t GetSearchLength() const
+	{
+		return m_search_length;
+	}
+
+	// Chunks take whole granules, alloc headers included, and the headers sit right before a granule boundary so every payload is
+	// granule aligned. The headers and footers store sizes in granules (minus the alloc header), so SIZE_MASK granules is the limit.
+	size_t GetGranularity() const
+	{
+		return size_t(1u) << m_granule_shift;
+	}
+
+	size_t GetMaxChunkSize() const
+	{
+		return DecodeChunkSize(SIZE_MASK);
+	}
+
+	// Bytes of the chunk after its alloc header, the stored size can be read from a header or a footer, flags are ignored
+	size_t DecodeChunkSize(const unsigned& stored_size) const
+	{
+		return DecodeChunkSize(stored_size, m_granule_shift, m_size_bias);
+	}
+
+	static size_t DecodeChunkSize(const unsigned& stored_size, const unsigned& granule_shift, const unsigned& size_bias)
+	{
+		return (static_cast<size_t>(stored_size & SIZE_MASK) << granule_shift) - size_bias;
+	}
+
+	// The boundary tag walk and checks for any buffer of these chunks, the segregated fit allocator uses them with plain byte sizes
+	// (granule shift and size bias of 0). Returns nullptr if the chunk is the last one of the buffer.
+	static FreeListAllocHeader* GetNextChunk(const std::span<std::byte>& buffer, const void* chunk, const unsigned& granule_shift, const unsigned& size_bias);
+
+	// Checks the alloc header at chunk and the boundary tags of its neighbours that have to agree with it
+	static bool IsAllocChunkValid(const std::span<std::byte>& buffer, const void* chunk, const unsigned& granule_shift, const unsigned& size_bias);
+
+	// Stored size of the smallest chunk that can hold chunk_size bytes
+	unsigned EncodeChunkSize(const size_t& chunk_size) const
+	{
+		return static_cast<unsigned>((chunk_size + m_size_bias + GetGranularity() - 1u) >> m_granule_shift);
+	}
+
+	size_t GetChunkSize(const void* chunk) const
+	{
+		return DecodeChunkSize(static_cast<const FreeListAllocHeader*>(chunk)->m_chunk_size);
+	}
+
+	// Size of the smallest chunk that can hold size_in_bytes, sizes that are not a whole number of granules get rounded up
+	size_t RoundChunkSize(const size_t& size_in_bytes) const
+	{
+		return DecodeChunkSize(EncodeChunkSize(size_in_bytes));
+	}
+
+	// Used by the allocation policies to walk their indexes
+	FreeListFreeHeader* ToChunk(const unsigned& offset) const
+	{
+		return offset == NULL_OFFSET ? nullptr : reinterpret_cast<FreeListFreeHeader*>(m_buffer.data() + (static_cast<size_t>(offset) << m_granule_shift));
+	}
+
+	unsigned ToOffset(const void* chunk) const
+	{
+		return chunk == nullptr ? NULL_OFFSET : static_cast<unsigned>(static_cast<size_t>(static_cast<const std::byte*>(chunk) - m_buffer.data()) >> m_granule_shift);
+	}
+
+	bool DoesChunkFit(const FreeListFreeHeader* free_chunk, const size_t& size_in_bytes, const size_t& alignment) const
+	{
+		const size_t chunk_size = GetChunkSize(free_chunk);
+		return chunk_size >= size_in_bytes && (alignment == 0u || chunk_size - size_in_bytes >= CalculateAlignmentPadding(free_chunk, alignment));
+	}
+
+	// Bytes between the alloc header and an aligned payload if we allocated at the given chunk
+	static unsigned CalculateAlignmentPadding(const FreeListFreeHeader* free_chunk, const size_t& alignment);
+
+protected:
+	// Returns the chunk physically after the given one, nullptr if the given one is the last chunk of the buffer
+	FreeListAllocHeader* GetNextChunk(const void* chunk) const;
+
+	// Returns the alloc header of the chunk the payload ptr belongs to, nullptr if it isnt a valid allocated chunk
+	FreeListAllocHeader* GetAllocHeader(void* ptr) const;
+
+	// Sets the granularity and the part of the buffer the chunks fit in, returns false if it cant be used
+	bool InitBuffer(std::span<std::byte>&& memory_buffer, const size_t& granularity);
+
+	void AddFreeChunkStats(const size_t& chunk_size);
+	void RemoveFreeChunkStats(const size_t& chunk_size);
+	void UpdateInUseStats();
+
+	size_t m_search_length = 0u;
+
+	FreeListStats m_stats{};
+
+	std::span<std::byte> m_buffer{};
+
+	unsigned m_granule_shift = 0u;
+	unsigned m_size_bias = 0u;			// Alloc header size when chunks take whole granules, 0 with plain byte sizes
+};
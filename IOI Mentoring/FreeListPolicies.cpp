@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * @filename FreeListPolicies.cpp
+ * @brief	 Contains the free list allocator allocation policy class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "FreeListPolicies.h"
+
+constexpr unsigned NULL_OFFSET = FreeListAllocatorBase::NULL_OFFSET;
+
+// Pushes the chunk at the front of the free list
+void FreeListIndex::Insert(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk)
+{
+	chunk->m_free_list_prev = NULL_OFFSET;
+	chunk->m_free_list_next = allocator.ToOffset(m_head);
+	if (m_head != nullptr)
+		m_head->m_free_list_prev = allocator.ToOffset(chunk);
+	m_head = chunk;
+}
+
+void FreeListIndex::Remove(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk)
+{
+	if (chunk == m_rover)
+		m_rover = allocator.ToChunk(chunk->m_free_list_next);
+
+	if (chunk->m_free_list_prev != NULL_OFFSET)
+		allocator.ToChunk(chunk->m_free_list_prev)->m_free_list_next = chunk->m_free_list_next;
+	else
+		m_head = allocator.ToChunk(chunk->m_free_list_next);
+
+	if (chunk->m_free_list_next != NULL_OFFSET)
+		allocator.ToChunk(chunk->m_free_list_next)->m_free_list_prev = chunk->m_free_list_prev;
+}
+
+// Puts new_chunk in the position old_chunk had in the free list
+void FreeListIndex::Replace(const FreeListAllocatorBase& allocator, FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk)
+{
+	// Read both links before writing, the chunks may overlap
+	const unsigned free_list_next = old_chunk->m_free_list_next;
+	const unsigned free_list_prev = old_chunk->m_free_list_prev;
+	if (old_chunk == m_rover)
+		m_rover = new_chunk;
+
+	new_chunk->m_free_list_next = free_list_next;
+	new_chunk->m_free_list_prev = free_list_prev;
+
+	if (free_list_prev != NULL_OFFSET)
+		allocator.ToChunk(free_list_prev)->m_free_list_next = allocator.ToOffset(new_chunk);
+	else
+		m_head = new_chunk;
+
+	if (free_list_next != NULL_OFFSET)
+		allocator.ToChunk(free_list_next)->m_free_list_prev = allocator.ToOffset(new_chunk);
+}
+
+// Hash of the chunk offset, as the offsets are unique so are the priorities (most of the time, ties are fine)
+static unsigned SizeTreePriority(const unsigned offset)
+{
+	unsigned hash = offset;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35u;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+// Orders by size, and by address when the sizes are the same so every key is unique
+static bool SizeTreeLess(const FreeListAllocatorBase::FreeListFreeHeader* chunk_0, const FreeListAllocatorBase::FreeListFreeHeader* chunk_1)
+{
+	return chunk_0->m_chunk_size < chunk_1->m_chunk_size || (chunk_0->m_chunk_size == chunk_1->m_chunk_size && chunk_0 < chunk_1);
+}
+
+unsigned SizeTreeIndex::TreeInsert(const FreeListAllocatorBase& allocator, const unsigned root, FreeListFreeHeader* chunk)
+{
+	if (root == NULL_OFFSET)
+	{
+		chunk->m_size_tree_left = NULL_OFFSET;
+		chunk->m_size_tree_right = NULL_OFFSET;
+		return allocator.ToOffset(chunk);
+	}
+
+	// If the chunk has a higher priority than the root it becomes the root of this subtree
+	FreeListFreeHeader* root_chunk = allocator.ToChunk(root);
+	if (SizeTreePriority(allocator.ToOffset(chunk)) > SizeTreePriority(root))
+	{
+		TreeSplit(allocator, root, chunk, chunk->m_size_tree_left, chunk->m_size_tree_right);
+		return allocator.ToOffset(chunk);
+	}
+
+	if (SizeTreeLess(chunk, root_chunk))
+		root_chunk->m_size_tree_left = TreeInsert(allocator, root_chunk->m_size_tree_left, chunk);
+	else
+		root_chunk->m_size_tree_right = TreeInsert(allocator, root_chunk->m_size_tree_right, chunk);
+
+	return root;
+}
+
+unsigned SizeTreeIndex::TreeRemove(const FreeListAllocatorBase& allocator, const unsigned root, FreeListFreeHeader* chunk)
+{
+	if (root == NULL_OFFSET)
+		return NULL_OFFSET;
+
+	// Once found, its children take its place
+	FreeListFreeHeader* root_chunk = allocator.ToChunk(root);
+	if (root_chunk == chunk)
+		return TreeMerge(allocator, chunk->m_size_tree_left, chunk->m_size_tree_right);
+
+	if (SizeTreeLess(chunk, root_chunk))
+		root_chunk->m_size_tree_left = TreeRemove(allocator, root_chunk->m_size_tree_left, chunk);
+	else
+		root_chunk->m_size_tree_right = TreeRemove(allocator, root_chunk->m_size_tree_right, chunk);
+
+	return root;
+}
+
+// Every key in left has to be smaller than every key in right
+unsigned SizeTreeIndex::TreeMerge(const FreeListAllocatorBase& allocator, const unsigned left, const unsigned right)
+{
+	if (left == NULL_OFFSET)
+		return right;
+	if (right == NULL_OFFSET)
+		return left;
+
+	FreeListFreeHeader* left_chunk = allocator.ToChunk(left);
+	FreeListFreeHeader* right_chunk = allocator.ToChunk(right);
+	if (SizeTreePriority(left) > SizeTreePriority(right))
+	{
+		left_chunk->m_size_tree_right = TreeMerge(allocator, left_chunk->m_size_tree_right, right);
+		return left;
+	}
+
+	right_chunk->m_size_tree_left = TreeMerge(allocator, left, right_chunk->m_size_tree_left);
+	return right;
+}
+
+// Splits the subtree into the keys smaller than the chunk's and the keys larger than it
+void SizeTreeIndex::TreeSplit(const FreeListAllocatorBase& allocator, const unsigned root, FreeListFreeHeader* chunk, unsigned& left, unsigned& right)
+{
+	if (root == NULL_OFFSET)
+	{
+		left = NULL_OFFSET;
+		right = NULL_OFFSET;
+		return;
+	}
+
+	FreeListFreeHeader* root_chunk = allocator.ToChunk(root);
+	if (SizeTreeLess(root_chunk, chunk))
+	{
+		left = root;
+		TreeSplit(allocator, root_chunk->m_size_tree_right, chunk, root_chunk->m_size_tree_right, right);
+	}
+	else
+	{
+		right = root;
+		TreeSplit(allocator, root_chunk->m_size_tree_left, chunk, left, root_chunk->m_size_tree_left);
+	}
+}
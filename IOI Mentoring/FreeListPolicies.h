@@ -0,0 +1,283 @@
+/***************************************************************************//**
+ * @filename FreeListPolicies.h
+ * @brief	 Contains the free list allocator allocation policy class headers.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "FreeListAllocatorBase.h"
+
+// A policy keeps the free chunks in an index and searches it. BasicFreeListAllocator takes it as a template parameter and calls it
+// directly, so the search is inlined into Allocate. Every policy has these functions, chunk sizes are up to date when they are called
+// and Resize takes the new stored size:
+//	void Clear();
+//	void Insert(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk);
+//	void Remove(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk);
+//	void Replace(const FreeListAllocatorBase& allocator, FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk);
+//	void Resize(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk, const unsigned& chunk_size);
+//	FreeListFreeHeader* Find(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length);
+
+// Unordered doubly linked list threaded through the free chunks, new chunks go in the front
+class FreeListIndex
+{
+public:
+	using FreeListFreeHeader = FreeListAllocatorBase::FreeListFreeHeader;
+
+	void Clear()
+	{
+		m_head = nullptr;
+		m_rover = nullptr;
+	}
+
+	// Pushes the chunk at the front of the free list
+	void Insert(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk);
+	void Remove(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk);
+
+	// Puts new_chunk in the position old_chunk had in the free list, they may overlap
+	void Replace(const FreeListAllocatorBase& allocator, FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk);
+
+	void Resize(const FreeListAllocatorBase&, FreeListFreeHeader* chunk, const unsigned& chunk_size)
+	{
+		chunk->m_chunk_size = chunk_size;
+	}
+
+	FreeListFreeHeader* FindFirstFit(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length) const
+	{
+		// LINEAR SEARCH for the first free chunk that can fit our bytes
+		FreeListFreeHeader* it = m_head;
+		while (it != nullptr)
+		{
+			search_length++;
+
+			if (allocator.DoesChunkFit(it, size_in_bytes, alignment))
+				return it;
+
+			it = allocator.ToChunk(it->m_free_list_next);
+		}
+
+		return nullptr;
+	}
+
+	FreeListFreeHeader* FindNextFit(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length)
+	{
+		if (m_rover == nullptr)
+			m_rover = m_head;
+
+		// LINEAR SEARCH from where the last allocation ended, wrapping around to the head of the free list once
+		FreeListFreeHeader* it = m_rover;
+		while (it != nullptr)
+		{
+			search_length++;
+
+			// The rover follows the chunk, it ends up on the remaining free chunk or on the next one in the list
+			if (allocator.DoesChunkFit(it, size_in_bytes, alignment))
+				return m_rover = it;
+
+			it = allocator.ToChunk(it->m_free_list_next);
+			if (it == nullptr)
+				it = m_head;
+			if (it == m_rover)
+				break;
+		}
+
+		return nullptr;
+	}
+
+private:
+	FreeListFreeHeader* m_head = nullptr;
+	FreeListFreeHeader* m_rover = nullptr;		// Where the next fit search starts, kept pointing at a chunk in the free list
+};
+
+// Size tree, a treap ordered by (size, address) threaded through the free chunks, the priorities are a hash of the offset so
+// they dont need to be stored
+class SizeTreeIndex
+{
+public:
+	using FreeListFreeHeader = FreeListAllocatorBase::FreeListFreeHeader;
+
+	void Clear()
+	{
+		m_root = FreeListAllocatorBase::NULL_OFFSET;
+	}
+
+	void Insert(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk)
+	{
+		m_root = TreeInsert(allocator, m_root, chunk);
+	}
+
+	void Remove(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk)
+	{
+		m_root = TreeRemove(allocator, m_root, chunk);
+	}
+
+	// The size tree is ordered by size so the new chunk has to be inserted again
+	void Replace(const FreeListAllocatorBase& allocator, FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk)
+	{
+		m_root = TreeRemove(allocator, m_root, old_chunk);
+		m_root = TreeInsert(allocator, m_root, new_chunk);
+	}
+
+	void Resize(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk, const unsigned& chunk_size)
+	{
+		m_root = TreeRemove(allocator, m_root, chunk);
+		chunk->m_chunk_size = chunk_size;
+		m_root = TreeInsert(allocator, m_root, chunk);
+	}
+
+	FreeListFreeHeader* FindBestFit(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length) const
+	{
+		FreeListFreeHeader* best_free_chunk = FindSmallest(allocator, allocator.EncodeChunkSize(size_in_bytes), search_length);
+
+		// The padding depends on where the chunk is, if the best chunk cant fit it then look for one that fits even the worst padding
+		if (best_free_chunk != nullptr && !allocator.DoesChunkFit(best_free_chunk, size_in_bytes, alignment))
+			best_free_chunk = size_in_bytes + alignment + sizeof(FreeListAllocatorBase::ALIGN_TAG) <= allocator.GetMaxChunkSize() ?
+							  FindSmallest(allocator, allocator.EncodeChunkSize(size_in_bytes + alignment + sizeof(FreeListAllocatorBase::ALIGN_TAG)), search_length) : nullptr;
+
+		return best_free_chunk;
+	}
+
+private:
+	// Smallest chunk that can fit the given stored size, O(log n) as we go down a single path of the tree
+	FreeListFreeHeader* FindSmallest(const FreeListAllocatorBase& allocator, const unsigned& chunk_size, size_t& search_length) const
+	{
+		FreeListFreeHeader* best_free_chunk = nullptr;
+
+		FreeListFreeHeader* it = allocator.ToChunk(m_root);
+		while (it != nullptr)
+		{
+			search_length++;
+
+			// If it fits everything to the right is worse, otherwise everything to the left is too small
+			if (it->m_chunk_size >= chunk_size)
+			{
+				best_free_chunk = it;
+				it = allocator.ToChunk(it->m_size_tree_left);
+			}
+			else
+				it = allocator.ToChunk(it->m_size_tree_right);
+		}
+
+		return best_free_chunk;
+	}
+
+	// All functions take and return subtree roots as offsets by value, as the roots passed in are often links of the chunks being modified
+	static unsigned TreeInsert(const FreeListAllocatorBase& allocator, const unsigned root, FreeListFreeHeader* chunk);
+	static unsigned TreeRemove(const FreeListAllocatorBase& allocator, const unsigned root, FreeListFreeHeader* chunk);
+	static unsigned TreeMerge(const FreeListAllocatorBase& allocator, const unsigned left, const unsigned right);
+	static void TreeSplit(const FreeListAllocatorBase& allocator, const unsigned root, FreeListFreeHeader* chunk, unsigned& left, unsigned& right);
+
+	unsigned m_root = FreeListAllocatorBase::NULL_OFFSET;
+};
+
+class FirstFitPolicy : public FreeListIndex
+{
+public:
+	FreeListFreeHeader* Find(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length)
+	{
+		return FindFirstFit(allocator, size_in_bytes, alignment, search_length);
+	}
+};
+
+class NextFitPolicy : public FreeListIndex
+{
+public:
+	FreeListFreeHeader* Find(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length)
+	{
+		return FindNextFit(allocator, size_in_bytes, alignment, search_length);
+	}
+};
+
+class BestFitPolicy : public SizeTreeIndex
+{
+public:
+	FreeListFreeHeader* Find(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length)
+	{
+		return FindBestFit(allocator, size_in_bytes, alignment, search_length);
+	}
+};
+
+// Picks the search at runtime so the alloc type can be changed after construction, FreeListAllocator uses it
+class RuntimeFitPolicy
+{
+public:
+	using FreeListFreeHeader = FreeListAllocatorBase::FreeListFreeHeader;
+
+	enum class e_AllocType { e_firstfit, e_bestfit, e_nextfit };
+
+	e_AllocType GetAllocType() const
+	{
+		return m_alloc_type;
+	}
+
+	// The free chunks only have room for one index, returns true if the new alloc type uses a different one and they have to be moved over
+	bool SetAllocType(const e_AllocType& alloc_type)
+	{
+		const bool used_size_tree = UsesSizeTree();
+		m_alloc_type = alloc_type;
+
+		return used_size_tree != UsesSizeTree();
+	}
+
+	void Clear()
+	{
+		m_free_list.Clear();
+		m_size_tree.Clear();
+	}
+
+	void Insert(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk)
+	{
+		if (UsesSizeTree())
+			m_size_tree.Insert(allocator, chunk);
+		else
+			m_free_list.Insert(allocator, chunk);
+	}
+
+	void Remove(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk)
+	{
+		if (UsesSizeTree())
+			m_size_tree.Remove(allocator, chunk);
+		else
+			m_free_list.Remove(allocator, chunk);
+	}
+
+	void Replace(const FreeListAllocatorBase& allocator, FreeListFreeHeader* old_chunk, FreeListFreeHeader* new_chunk)
+	{
+		if (UsesSizeTree())
+			m_size_tree.Replace(allocator, old_chunk, new_chunk);
+		else
+			m_free_list.Replace(allocator, old_chunk, new_chunk);
+	}
+
+	void Resize(const FreeListAllocatorBase& allocator, FreeListFreeHeader* chunk, const unsigned& chunk_size)
+	{
+		if (UsesSizeTree())
+			m_size_tree.Resize(allocator, chunk, chunk_size);
+		else
+			m_free_list.Resize(allocator, chunk, chunk_size);
+	}
+
+	FreeListFreeHeader* Find(const FreeListAllocatorBase& allocator, const size_t& size_in_bytes, const size_t& alignment, size_t& search_length)
+	{
+		switch (m_alloc_type)
+		{
+		case e_AllocType::e_bestfit:
+			return m_size_tree.FindBestFit(allocator, size_in_bytes, alignment, search_length);
+		case e_AllocType::e_nextfit:
+			return m_free_list.FindNextFit(allocator, size_in_bytes, alignment, search_length);
+		default:
+			return m_free_list.FindFirstFit(allocator, size_in_bytes, alignment, search_length);
+		}
+	}
+
+private:
+	bool UsesSizeTree() const
+	{
+		return m_alloc_type == e_AllocType::e_bestfit;
+	}
+
+	e_AllocType m_alloc_type = e_AllocType::e_firstfit;
+
+	FreeListIndex m_free_list;
+	SizeTreeIndex m_size_tree;
+};
@@ -0,0 +1,215 @@
+/***************************************************************************//**
+ * @filename GrowablePoolAllocator.cpp
+ * @brief	 Contains the growable pool allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "GrowablePoolAllocator.h"
+
+GrowablePoolAllocator::~GrowablePoolAllocator()
+{
+	for (auto& [memory, slab] : m_slabs)
+		m_upstream->FreeSlab(slab->m_memory, m_slab_size, m_slab_size);
+}
+
+void GrowablePoolAllocator::Init(const unsigned& chunk_size_in_bytes, const size_t& slab_size, ISlabSource& upstream, const unsigned& max_free_slabs)
+{
+	if (!std::has_single_bit(slab_size))
+	{
+		debug_print("ERROR [GrowablePoolAllocator.cpp, GrowablePoolAllocator, void Init(const unsigned&, const size_t&, ISlabSource&, const unsigned&)]: Slab size has to be a power of two.");
+		return;
+	}
+
+	if (chunk_size_in_bytes == 0u || chunk_size_in_bytes > slab_size)
+	{
+		debug_print("ERROR [GrowablePoolAllocator.cpp, GrowablePoolAllocator, void Init(const unsigned&, const size_t&, ISlabSource&, const unsigned&)]: Chunk size has to be between 1 byte and slab size.");
+		return;
+	}
+
+	if (chunk_size_in_bytes < PoolAllocator::GetMinChunkSize(slab_size / chunk_size_in_bytes))
+	{
+		debug_print("ERROR [GrowablePoolAllocator.cpp, GrowablePoolAllocator, void Init(const unsigned&, const size_t&, ISlabSource&, const unsigned&)]: Chunk size was less than the free list link (2 bytes up to 65535 chunks per slab, 4 bytes otherwise).");
+		return;
+	}
+
+	// Slabs of the previous Init go back to the source they came from
+	for (auto& [memory, slab] : m_slabs)
+		m_upstream->FreeSlab(slab->m_memory, m_slab_size, m_slab_size);
+	m_slabs.clear();
+
+	m_chunk_size = chunk_size_in_bytes;
+	m_chunks_per_slab = static_cast<unsigned>(slab_size / chunk_size_in_bytes);
+	m_slab_size = slab_size;
+	m_upstream = &upstream;
+	m_max_free_slabs = max_free_slabs;
+	m_free_slab_count = 0u;
+	m_free_chunk_count = 0u;
+	m_available_head = nullptr;
+}
+
+GrowablePoolAllocator::Slab* GrowablePoolAllocator::FindSlab(const void* ptr) const
+{
+	// Slabs are aligned to their size, so rounding down gives the start of the slab the ptr would be in
+	const std::byte* slab_memory = reinterpret_cast<const std::byte*>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(m_slab_size - 1u));
+
+	auto it = m_slabs.find(slab_memory);
+	return it != m_slabs.end() ? it->second.get() : nullptr;
+}
+
+GrowablePoolAllocator::Slab* GrowablePoolAllocator::AddSlab()
+{
+	std::byte* memory = static_cast<std::byte*>(m_upstream->AllocateSlab(m_slab_size, m_slab_size));
+	if (memory == nullptr)
+		return nullptr;
+
+	// The chunks that fit, the tail of the slab is left unused when the chunk size doesnt divide the slab size
+	std::unique_ptr<Slab> slab = std::make_unique<Slab>();
+	slab->m_memory = memory;
+	slab->m_pool.Init(std::span<std::byte>(memory, static_cast<size_t>(m_chunks_per_slab) * m_chunk_size), m_chunk_size);
+
+	Slab* new_slab = slab.get();
+	m_slabs.emplace(memory, std::move(slab));
+
+	m_free_chunk_count += m_chunks_per_slab;
+	m_free_slab_count++;
+	LinkAvailable(new_slab);
+
+	return new_slab;
+}
+
+void GrowablePoolAllocator::ReleaseSlab(Slab* slab)
+{
+	UnlinkAvailable(slab);
+	m_free_chunk_count -= m_chunks_per_slab;
+	m_free_slab_count--;
+
+	m_upstream->FreeSlab(slab->m_memory, m_slab_size, m_slab_size);
+	m_slabs.erase(slab->m_memory);
+}
+
+void GrowablePoolAllocator::LinkAvailable(Slab* slab)
+{
+	if (slab->m_available)
+		return;
+
+	slab->m_available_prev = nullptr;
+	slab->m_available_next = m_available_head;
+	if (m_available_head != nullptr)
+		m_available_head->m_available_prev = slab;
+	m_available_head = slab;
+	slab->m_available = true;
+}
+
+void GrowablePoolAllocator::UnlinkAvailable(Slab* slab)
+{
+	if (!slab->m_available)
+		return;
+
+	if (slab->m_available_prev != nullptr)
+		slab->m_available_prev->m_available_next = slab->m_available_next;
+	else
+		m_available_head = slab->m_available_next;
+
+	if (slab->m_available_next != nullptr)
+		slab->m_available_next->m_available_prev = slab->m_available_prev;
+
+	slab->m_available = false;
+}
+
+void* GrowablePoolAllocator::Allocate()
+{
+	if (m_upstream == nullptr)
+		return nullptr;
+
+	// All slabs are full, grow
+	Slab* slab = m_available_head != nullptr ? m_available_head : AddSlab();
+	if (slab == nullptr)
+	{
+		debug_print("ERROR [GrowablePoolAllocator.cpp, GrowablePoolAllocator, void* Allocate()]: Upstream source could not give us a new slab.");
+		return nullptr;
+	}
+
+	if (slab->m_pool.GetFreeChunkAmount() == m_chunks_per_slab)
+		m_free_slab_count--;
+
+	void* chunk = slab->m_pool.Allocate();
+	m_free_chunk_count--;
+
+	if (slab->m_pool.GetFreeChunkAmount() == 0u)
+		UnlinkAvailable(slab);
+
+	return chunk;
+}
+
+void GrowablePoolAllocator::Free(void* ptr)
+{
+	// If its already free then do nothing
+	if (IsChunkFree(ptr))
+		return;
+
+	Slab* slab = FindSlab(ptr);
+	slab->m_pool.Free(ptr);
+	m_free_chunk_count++;
+
+	// It has free chunks again, allocate from it before touching emptier slabs
+	LinkAvailable(slab);
+
+	if (slab->m_pool.GetFreeChunkAmount() == m_chunks_per_slab)
+	{
+		m_free_slab_count++;
+		if (m_free_slab_count > m_max_free_slabs)
+			ReleaseSlab(slab);
+	}
+}
+
+bool GrowablePoolAllocator::IsChunkFree(void* ptr) const
+{
+	if (!IsChunkPtrValid(ptr))
+		return true;
+
+	return FindSlab(ptr)->m_pool.IsChunkFree(ptr);
+}
+
+bool GrowablePoolAllocator::IsChunkPtrValid(void* ptr) const
+{
+	if (ptr == nullptr)
+		return false;
+
+	const Slab* slab = FindSlab(ptr);
+	if (slab == nullptr)
+	{
+		debug_print("ERROR [GrowablePoolAllocator.cpp, GrowablePoolAllocator, bool IsChunkPtrValid(void*)]: Ptr to deallocate was not in any slab.");
+		return false;
+	}
+
+	// The slab checks the ptr is the start of one of its chunks
+	return slab->m_pool.IsChunkPtrValid(ptr);
+}
+
+void GrowablePoolAllocator::Clear()
+{
+	m_available_head = nullptr;
+	m_free_slab_count = 0u;
+	m_free_chunk_count = 0u;
+
+	// Every slab is free now, keep the allowed amount of them
+	for (auto it = m_slabs.begin(); it != m_slabs.end();)
+	{
+		Slab* slab = it->second.get();
+		if (m_free_slab_count == m_max_free_slabs)
+		{
+			m_upstream->FreeSlab(slab->m_memory, m_slab_size, m_slab_size);
+			it = m_slabs.erase(it);
+			continue;
+		}
+
+		slab->m_pool.Clear();
+		slab->m_available = false;
+		LinkAvailable(slab);
+		m_free_slab_count++;
+		m_free_chunk_count += m_chunks_per_slab;
+		++it;
+	}
+}
@@ -0,0 +1,97 @@
+/***************************************************************************//**
+ * @filename GrowablePoolAllocator.h
+ * @brief	 Contains the growable pool allocator class header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "PoolAllocator.h"
+#include "SlabSource.h"
+
+// Pool allocator that takes a new slab from its upstream source when all of its slabs are full, instead of failing. Every slab is a
+// PoolAllocator of its own, so new slabs are ready in O(1). Slabs are aligned to their size, the slab a chunk belongs to is found by
+// rounding its address down. Slabs with free chunks are chained so allocating never looks at full ones, and slabs that become
+// completely free are given back upstream once there are more than the allowed amount of them.
+class GrowablePoolAllocator : public IAllocator
+{
+public:
+	GrowablePoolAllocator() = default;
+	~GrowablePoolAllocator();
+
+	GrowablePoolAllocator(const GrowablePoolAllocator&) = delete;
+	GrowablePoolAllocator& operator=(const GrowablePoolAllocator&) = delete;
+
+	// slab_size has to be a power of two that fits at least one chunk. The upstream source has to outlive the allocator.
+	void Init(const unsigned& chunk_size_in_bytes, const size_t& slab_size, ISlabSource& upstream = HeapSlabSource::Get(), const unsigned& max_free_slabs = 1u);
+
+	void* Allocate();
+
+	void Free(void* ptr);
+
+	// O(1), invalid ptrs count as free so they are never freed
+	bool IsChunkFree(void* ptr) const;
+
+	// O(1), finds the slab the ptr would belong to and checks it is one of ours
+	bool IsChunkPtrValid(void* ptr) const;
+
+	// Every chunk is freed and the slabs past the allowed amount of free ones are given back
+	void Clear();
+
+	size_t GetChunkSize() const
+	{
+		return m_chunk_size;
+	}
+
+	size_t GetSlabSize() const
+	{
+		return m_slab_size;
+	}
+
+	unsigned GetSlabCount() const
+	{
+		return static_cast<unsigned>(m_slabs.size());
+	}
+
+	// Free chunks in the slabs we have, the ones the upstream source could still give us are not counted
+	size_t GetFreeChunkAmount() const
+	{
+		return m_free_chunk_count;
+	}
+
+private:
+	struct Slab
+	{
+		PoolAllocator m_pool;
+		std::byte* m_memory = nullptr;
+
+		// Links of the chain of slabs with free chunks
+		Slab* m_available_next = nullptr;
+		Slab* m_available_prev = nullptr;
+		bool m_available = false;
+	};
+
+	// nullptr if the ptr isnt in any of our slabs
+	Slab* FindSlab(const void* ptr) const;
+
+	Slab* AddSlab();
+	void ReleaseSlab(Slab* slab);
+
+	void LinkAvailable(Slab* slab);
+	void UnlinkAvailable(Slab* slab);
+
+	unsigned m_chunk_size = 0u;
+	unsigned m_chunks_per_slab = 0u;
+	size_t m_slab_size = 0u;
+
+	ISlabSource* m_upstream = nullptr;
+	unsigned m_max_free_slabs = 0u;
+	unsigned m_free_slab_count = 0u;		// Slabs with every chunk free
+
+	size_t m_free_chunk_count = 0u;
+
+	// Slab start address to slab
+	std::unordered_map<const std::byte*, std::unique_ptr<Slab>> m_slabs;
+	Slab* m_available_head = nullptr;
+};
@@ -13,8 +13,27 @@ class IAllocator
 public:
 	virtual void Clear() = 0;
 
-	static uintptr_t CalculatePadding(const uintptr_t& alloc_address, const size_t& alignment)
+	// Bytes from the address to the next address with the given alignment, which has to be a power of two
+	static constexpr uintptr_t CalculatePadding(const uintptr_t& alloc_address, const size_t& alignment)
 	{
-		return alloc_address % alignment;
+		return (0u - alloc_address) & static_cast<uintptr_t>(alignment - 1u);
+	}
+
+	// Same with the alignment known at compile time, the mask is a constant
+	template <size_t ALIGNMENT>
+	static constexpr uintptr_t CalculatePadding(const uintptr_t& alloc_address)
+	{
+		static_assert(std::has_single_bit(ALIGNMENT), "Alignment has to be a power of two.");
+		return (0u - alloc_address) & static_cast<uintptr_t>(ALIGNMENT - 1u);
+	}
+
+	static constexpr uintptr_t AlignForward(const uintptr_t& address, const size_t& alignment)
+	{
+		return (address + alignment - 1u) & ~static_cast<uintptr_t>(alignment - 1u);
+	}
+
+	static constexpr bool IsAligned(const uintptr_t& address, const size_t& alignment)
+	{
+		return (address & static_cast<uintptr_t>(alignment - 1u)) == 0u;
 	}
 };
\ No newline at end of file
@@ -22,27 +22,38 @@ void LinearAllocator::Init(std::span<std::byte>&& memory_buffer)
 
 void* LinearAllocator::Allocate(size_t size_in_bytes, const size_t& alignment)
 {
-	if (size_in_bytes == 0u)
+	if (alignment != 0u && !std::has_single_bit(alignment))
 	{
-		debug_print("ERROR [LinearAllocator.cpp, LinearAllocator, void Init(std::span<std::byte>)]: Allocation size cannot be zero.");
+		debug_print("ERROR [LinearAllocator.cpp, LinearAllocator, void* Allocate(size_t, const size_t&)]: Alignment has to be a power of two.");
 		return nullptr;
 	}
 
-	if (alignment != 0u)
-		size_in_bytes += CalculatePadding(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset + size_in_bytes, alignment);
+	const size_t padding = alignment != 0u ? CalculatePadding(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset, alignment) : 0u;
+
+	return AllocateWithPadding(size_in_bytes, padding);
+}
+
+void* LinearAllocator::AllocateWithPadding(const size_t& size_in_bytes, const size_t& padding)
+{
+	if (size_in_bytes == 0u)
+	{
+		debug_print("ERROR [LinearAllocator.cpp, LinearAllocator, void* AllocateWithPadding(const size_t&, const size_t&)]: Allocation size cannot be zero.");
+		return nullptr;
+	}
 
 	// If the requested size cannot be allocated then dont attempt
-	if (m_offset + size_in_bytes > m_buffer.size())
+	if (padding + size_in_bytes > m_buffer.size() - m_offset)
 	{
-		debug_print("ERROR [LinearAllocator.cpp, LinearAllocator, void* Allocate(size_t, const size_t&)]: Allocation is too large for remaining buffer.");
+		debug_print("ERROR [LinearAllocator.cpp, LinearAllocator, void* AllocateWithPadding(const size_t&, const size_t&)]: Allocation is too large for remaining buffer.");
 		return nullptr;
 	}
 
-	// Update the offset by "moving" it by the given size
-	m_offset += size_in_bytes;
+	// Skip the padding and "move" the offset past the block
+	std::byte* block = m_buffer.data() + m_offset + padding;
+	m_offset += padding + size_in_bytes;
 
 	// Return pointer to allocated block
-	return &m_buffer[m_offset - size_in_bytes];
+	return block;
 }
 
 void LinearAllocator::Clear()
@@ -55,4 +66,15 @@ void LinearAllocator::Free()
 {
 	// Linear allocators just clear the whole buffer
 	Clear();
-}
\ No newline at end of file
+}
+
+void LinearAllocator::FreeToMarker(const Marker& marker)
+{
+	if (marker > m_offset)
+	{
+		debug_print("ERROR [LinearAllocator.cpp, LinearAllocator, void FreeToMarker(const Marker&)]: Marker is past the current offset.");
+		return;
+	}
+
+	m_offset = marker;
+}
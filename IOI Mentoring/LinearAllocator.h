@@ -11,14 +11,32 @@
 class LinearAllocator : public IAllocator
 {
 public:
+	// Offset to rewind to, everything allocated after it is freed at once
+	using Marker = size_t;
+
 	void Init(std::span<std::byte>&& memory_buffer);
 
+	// alignment has to be 0 (none) or a power of two
 	void* Allocate(size_t size_in_bytes, const size_t& alignment = 0u);
 
+	template <size_t ALIGNMENT>
+	void* Allocate(const size_t& size_in_bytes)
+	{
+		return AllocateWithPadding(size_in_bytes, CalculatePadding<ALIGNMENT>(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset));
+	}
+
 	void Free();
 
 	void Clear();
 
+	Marker GetMarker() const
+	{
+		return m_offset;
+	}
+
+	// O(1), the marker has to come from GetMarker and not be past the current offset
+	void FreeToMarker(const Marker& marker);
+
 	size_t GetOffset() const
 	{
 		return m_offset;
@@ -29,7 +47,16 @@ public:
 		return m_buffer.size();
 	}
 
+	// Whether the ptr is in the allocated part of the buffer
+	bool IsPtrAllocated(const void* ptr) const
+	{
+		return ptr >= m_buffer.data() && ptr < m_buffer.data() + m_offset;
+	}
+
 private:
+	// The padding goes before the allocation so it starts at an aligned address
+	void* AllocateWithPadding(const size_t& size_in_bytes, const size_t& padding);
+
 	std::span<std::byte> m_buffer{};		// Would be void* if it were typed
 	size_t m_offset = 0;
 }; 
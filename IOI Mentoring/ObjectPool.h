@@ -0,0 +1,229 @@
+/***************************************************************************//**
+ * @filename ObjectPool.h
+ * @brief	 Contains the typed object pool class template, built on the pool
+ *			 allocator.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "PoolAllocator.h"
+
+// Pool of objects of type T that are constructed and destroyed in place. Objects are referred to by 32-bit handles: the low INDEX_BITS
+// are the chunk index and the rest a generation. Every chunk has a generation, bumped when an object is created in it and again when
+// it is destroyed, so it is odd while the chunk holds an object. A handle is only valid while its generation matches the chunk's one,
+// which makes catching stale handles a single compare (after the bounds check). Generations wrap around, so a handle is stale for 2^(31 - INDEX_BITS) reuses.
+template <typename T, unsigned INDEX_BITS = 20u>
+class ObjectPool : public IAllocator
+{
+public:
+	static_assert(INDEX_BITS > 0u && INDEX_BITS < 32u, "Handles need room for the index and at least one generation bit.");
+
+	static constexpr unsigned GENERATION_BITS = 32u - INDEX_BITS;
+	static constexpr uint32_t INDEX_MASK = (uint32_t(1u) << INDEX_BITS) - 1u;
+	static constexpr uint32_t GENERATION_MASK = ~uint32_t(0u) >> INDEX_BITS;
+
+	// Chunks have to fit a T and the pool's free list link (whatever the pool size), and be a multiple of the alignment so every
+	// chunk is aligned. The links are copied byte by byte so they dont add to the alignment.
+	static constexpr size_t CHUNK_ALIGNMENT = alignof(T);
+	static constexpr size_t CHUNK_SIZE = (std::max<size_t>(sizeof(T), PoolAllocator::MAX_LINK_SIZE) + CHUNK_ALIGNMENT - 1u) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+
+	// Index INDEX_MASK is never used, so the null handle (all ones) is never valid
+	static constexpr uint32_t NULL_HANDLE = ~uint32_t(0u);
+
+	// Default constructed handles are null
+	struct Handle
+	{
+		uint32_t m_value = NULL_HANDLE;
+
+		uint32_t GetIndex() const
+		{
+			return m_value & INDEX_MASK;
+		}
+
+		uint32_t GetGeneration() const
+		{
+			return m_value >> INDEX_BITS;
+		}
+
+		bool IsNull() const
+		{
+			return m_value == NULL_HANDLE;
+		}
+
+		bool operator==(const Handle& other) const
+		{
+			return m_value == other.m_value;
+		}
+	};
+
+	ObjectPool() = default;
+
+	// Destroys the objects that are still alive
+	~ObjectPool()
+	{
+		Clear();
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	// The buffer is trimmed to the chunk alignment and a whole number of chunks, and to the chunks an index can address
+	void Init(std::span<std::byte>&& memory_buffer);
+
+	// Null handle if there is no room
+	template <typename... Args>
+	Handle Create(Args&&... args);
+
+	// Stale and null handles are ignored
+	void Destroy(const Handle& handle);
+
+	// nullptr if the handle is stale or null. Free chunks have an even generation, so handles with one never match.
+	T* Get(const Handle& handle) const
+	{
+		const uint32_t index = handle.GetIndex();
+		return handle.GetGeneration() % 2u == 1u && index < m_capacity && m_generations[index] == handle.GetGeneration() ? GetObject(index) : nullptr;
+	}
+
+	bool IsValid(const Handle& handle) const
+	{
+		return Get(handle) != nullptr;
+	}
+
+	// Handle of an object of the pool, null if the ptr isnt one
+	Handle GetHandle(const T* object) const;
+
+	// Calls fn(handle, object) with every live object in address order, fn may destroy the object it is given
+	template <typename Fn>
+	void ForEach(Fn&& fn)
+	{
+		m_pool.ForEachAllocatedChunk([this, &fn](void* chunk)
+			{
+				const uint32_t index = GetIndex(chunk);
+				fn(MakeHandle(index), *GetObject(index));
+			});
+	}
+
+	// Destroys every live object, their handles become stale
+	void Clear();
+
+	unsigned GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	unsigned GetLiveCount() const
+	{
+		return m_capacity - m_pool.GetFreeChunkAmount();
+	}
+
+private:
+	T* GetObject(const uint32_t& index) const
+	{
+		return reinterpret_cast<T*>(m_objects + static_cast<size_t>(index) * CHUNK_SIZE);
+	}
+
+	uint32_t GetIndex(const void* object) const
+	{
+		return static_cast<uint32_t>(static_cast<size_t>(static_cast<const std::byte*>(object) - m_objects) / CHUNK_SIZE);
+	}
+
+	Handle MakeHandle(const uint32_t& index) const
+	{
+		return Handle{ m_generations[index] << INDEX_BITS | index };
+	}
+
+	PoolAllocator m_pool;
+	std::byte* m_objects = nullptr;
+	unsigned m_capacity = 0u;
+
+	// One per chunk, outside the buffer so the objects keep all their bytes
+	std::unique_ptr<uint32_t[]> m_generations;
+};
+
+template <typename T, unsigned INDEX_BITS>
+void ObjectPool<T, INDEX_BITS>::Init(std::span<std::byte>&& memory_buffer)
+{
+	Clear();
+
+	// Skip the bytes before the first aligned address
+	void* first_chunk = memory_buffer.data();
+	size_t space = memory_buffer.size();
+	if (std::align(CHUNK_ALIGNMENT, CHUNK_SIZE, first_chunk, space) == nullptr)
+	{
+		debug_print("ERROR [ObjectPool.h, ObjectPool, void Init(std::span<std::byte>&&)]: Buffer cannot fit a single object.");
+		return;
+	}
+
+	const size_t capacity = std::min<size_t>(space / CHUNK_SIZE, INDEX_MASK);
+
+	m_objects = static_cast<std::byte*>(first_chunk);
+	m_capacity = static_cast<unsigned>(capacity);
+	m_generations = std::make_unique<uint32_t[]>(m_capacity);
+	m_pool.Init(std::span<std::byte>(m_objects, capacity * CHUNK_SIZE), static_cast<unsigned>(CHUNK_SIZE));
+}
+
+template <typename T, unsigned INDEX_BITS>
+template <typename... Args>
+typename ObjectPool<T, INDEX_BITS>::Handle ObjectPool<T, INDEX_BITS>::Create(Args&&... args)
+{
+	void* chunk = m_pool.Allocate();
+	if (chunk == nullptr)
+		return Handle{};
+
+	// Odd from now on, the generation wraps around from GENERATION_MASK (odd) to 0 (even) so the parity is kept
+	const uint32_t index = GetIndex(chunk);
+	m_generations[index] = (m_generations[index] + 1u) & GENERATION_MASK;
+
+	new (chunk) T(std::forward<Args>(args)...);
+	return MakeHandle(index);
+}
+
+template <typename T, unsigned INDEX_BITS>
+void ObjectPool<T, INDEX_BITS>::Destroy(const Handle& handle)
+{
+	T* object = Get(handle);
+	if (object == nullptr)
+	{
+		if (!handle.IsNull())
+			debug_print("ERROR [ObjectPool.h, ObjectPool, void Destroy(const Handle&)]: Handle to destroy was stale.");
+		return;
+	}
+
+	object->~T();
+
+	// Even again, every handle to it is stale now
+	const uint32_t index = handle.GetIndex();
+	m_generations[index] = (m_generations[index] + 1u) & GENERATION_MASK;
+	m_pool.Free(object);
+}
+
+template <typename T, unsigned INDEX_BITS>
+typename ObjectPool<T, INDEX_BITS>::Handle ObjectPool<T, INDEX_BITS>::GetHandle(const T* object) const
+{
+	const std::byte* chunk = reinterpret_cast<const std::byte*>(object);
+	if (chunk < m_objects || chunk >= m_objects + static_cast<size_t>(m_capacity) * CHUNK_SIZE || (chunk - m_objects) % CHUNK_SIZE != 0)
+		return Handle{};
+
+	// Even generation, the chunk is free
+	const uint32_t index = GetIndex(chunk);
+	return m_generations[index] % 2u == 1u ? MakeHandle(index) : Handle{};
+}
+
+template <typename T, unsigned INDEX_BITS>
+void ObjectPool<T, INDEX_BITS>::Clear()
+{
+	if (m_capacity == 0u)
+		return;
+
+	// Only chunks that hold an object are visited
+	m_pool.ForEachAllocatedChunk([this](void* chunk)
+		{
+			const uint32_t index = GetIndex(chunk);
+			static_cast<T*>(chunk)->~T();
+			m_generations[index] = (m_generations[index] + 1u) & GENERATION_MASK;
+		});
+
+	m_pool.Clear();
+}
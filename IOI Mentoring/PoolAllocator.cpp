@@ -7,47 +7,186 @@
 #include "pch.h"
 #include "PoolAllocator.h"
 
-void PoolAllocator::Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes)
+bool PoolAllocator::InitBuffer(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes)
 {
 	if (memory_buffer.size() == 0)
 	{
-		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Buffer size cannot be zero.");
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, bool InitBuffer(std::span<std::byte>&&, const unsigned&)]: Buffer size cannot be zero.");
+		return false;
+	}
+
+	if (chunk_size_in_bytes == 0 || memory_buffer.size() % chunk_size_in_bytes != 0)
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, bool InitBuffer(std::span<std::byte>&&, const unsigned&)]: Chunk size was not a multiple of buffer size.");
+		return false;
+	}
+
+	if (memory_buffer.size() / chunk_size_in_bytes >= NULL_INDEX)
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, bool InitBuffer(std::span<std::byte>&&, const unsigned&)]: Chunk count cannot be more than 2^32 - 2.");
+		return false;
+	}
+
+	if (chunk_size_in_bytes < GetMinChunkSize(memory_buffer.size() / chunk_size_in_bytes))
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, bool InitBuffer(std::span<std::byte>&&, const unsigned&)]: Chunk size was less than the free list link (2 bytes up to 65535 chunks, 4 bytes otherwise).");
+		return false;
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+	m_chunk_size = chunk_size_in_bytes;
+	m_chunk_count = static_cast<unsigned>(m_buffer.size() / m_chunk_size);
+	m_link_size = GetMinChunkSize(GetChunkCount());
+	m_occupancy_bitmap = std::make_unique_for_overwrite<uint64_t[]>((GetChunkCount() + 63u) / 64u);
+
+	return true;
+}
+
+void PoolAllocator::Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes)
+{
+	if (!InitBuffer(std::forward<std::span<std::byte>>(memory_buffer), chunk_size_in_bytes))
+		return;
+
+	m_header = &m_local_header;
+	*m_header = PoolHeader{ HEADER_MAGIC, m_chunk_size, m_chunk_count, m_link_size };
+
+	Clear();
+}
+
+void PoolAllocator::Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes, const size_t& alignment, const bool& isolated)
+{
+	if (alignment != 0u && !std::has_single_bit(alignment))
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Init(std::span<std::byte>&&, const unsigned&, const size_t&, const bool&)]: Alignment has to be a power of two.");
 		return;
 	}
 
-	if (chunk_size_in_bytes < sizeof(PoolAllocationHeader))
+	// Isolated chunks start on a cache line and are padded to whole lines
+	const size_t chunk_alignment = std::max<size_t>({ alignment, isolated ? CACHE_LINE_SIZE : 1u, 1u });
+	const size_t chunk_size = static_cast<size_t>(AlignForward(chunk_size_in_bytes, chunk_alignment));
+
+	// Skip the bytes before the first aligned address and the ones after the last whole chunk
+	const size_t front_padding = static_cast<size_t>(CalculatePadding(reinterpret_cast<uintptr_t>(memory_buffer.data()), chunk_alignment));
+	if (chunk_size == 0u || memory_buffer.size() < front_padding + chunk_size)
 	{
-		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Chunk size was less than header size (std::byte*).");
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Init(std::span<std::byte>&&, const unsigned&, const size_t&, const bool&)]: Buffer cannot fit a single aligned chunk.");
 		return;
 	}
 
-	if (memory_buffer.size() % chunk_size_in_bytes != 0)
+	const size_t chunk_count = (memory_buffer.size() - front_padding) / chunk_size;
+	Init(memory_buffer.subspan(front_padding, chunk_count * chunk_size), static_cast<unsigned>(chunk_size));
+}
+
+void PoolAllocator::InitWithHeader(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes)
+{
+	if (!IsAligned(reinterpret_cast<uintptr_t>(memory_buffer.data()), alignof(PoolHeader)) || memory_buffer.size() < HEADER_SIZE + chunk_size_in_bytes || chunk_size_in_bytes == 0u)
 	{
-		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Init(std::span<std::byte>&&, const unsigned&)]: Chunk size was not a multiple of buffer size.");
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void InitWithHeader(std::span<std::byte>&&, const unsigned&)]: Buffer cannot fit the header and a chunk, or it isnt aligned to the header.");
 		return;
 	}
 
-	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
-	m_chunk_size = chunk_size_in_bytes;
+	// Chunks go after the header, up to the last whole one
+	const size_t chunk_count = (memory_buffer.size() - HEADER_SIZE) / chunk_size_in_bytes;
+	if (!InitBuffer(memory_buffer.subspan(HEADER_SIZE, chunk_count * chunk_size_in_bytes), chunk_size_in_bytes))
+		return;
+
+	m_header = new (memory_buffer.data()) PoolHeader{ HEADER_MAGIC, m_chunk_size, m_chunk_count, m_link_size };
 
 	Clear();
 }
 
+void PoolAllocator::Open(std::span<std::byte>&& memory_buffer)
+{
+	// Whatever happens the previous buffer is no longer used
+	m_buffer = {};
+	m_chunk_size = 0u;
+	m_chunk_count = 0u;
+	m_link_size = 0u;
+	m_header = &m_local_header;
+	*m_header = PoolHeader{};
+
+	if (!IsAligned(reinterpret_cast<uintptr_t>(memory_buffer.data()), alignof(PoolHeader)) || memory_buffer.size() < HEADER_SIZE)
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Open(std::span<std::byte>&&)]: Buffer cannot fit the header, or it isnt aligned to it.");
+		return;
+	}
+
+	// The sizes have to be the ones InitWithHeader would have written for this buffer
+	PoolHeader* header = reinterpret_cast<PoolHeader*>(memory_buffer.data());
+	if (header->m_magic != HEADER_MAGIC || header->m_chunk_size == 0u || header->m_chunk_count == 0u || header->m_chunk_count >= NULL_INDEX ||
+		header->m_link_size != GetMinChunkSize(header->m_chunk_count) || header->m_chunk_size < header->m_link_size ||
+		static_cast<size_t>(header->m_chunk_count) * header->m_chunk_size > memory_buffer.size() - HEADER_SIZE ||
+		header->m_bump_index > header->m_chunk_count || header->m_free_chunk_count > header->m_chunk_count ||
+		header->m_free_chunk_count < header->m_chunk_count - header->m_bump_index)
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Open(std::span<std::byte>&&)]: Buffer doesnt have a valid pool header.");
+		return;
+	}
+
+	InitBuffer(memory_buffer.subspan(HEADER_SIZE, static_cast<size_t>(header->m_chunk_count) * header->m_chunk_size), header->m_chunk_size);
+
+	// Every chunk before the bump index is allocated but the ones in the free list, the words past it are zeroed when it enters them
+	const unsigned bump_index = header->m_bump_index;
+	for (unsigned word = 0u; word < (bump_index + 63u) / 64u; word++)
+		m_occupancy_bitmap[word] = bump_index - word * 64u >= 64u ? ~uint64_t(0u) : (uint64_t(1u) << (bump_index - word * 64u)) - 1u;
+
+	// Only the chunks in the free list are read, a link that leaves the used chunks or comes back to a free one means the buffer is broken
+	m_header = header;
+	const unsigned free_list_length = header->m_free_chunk_count - (header->m_chunk_count - bump_index);
+	unsigned chunk_index = header->m_free_list_head;
+	for (unsigned i = 0u; i < free_list_length; i++)
+	{
+		if (chunk_index >= bump_index || !(m_occupancy_bitmap[chunk_index / 64u] & (uint64_t(1u) << (chunk_index % 64u))))
+		{
+			chunk_index = 0u;
+			break;
+		}
+
+		m_occupancy_bitmap[chunk_index / 64u] &= ~(uint64_t(1u) << (chunk_index % 64u));
+		chunk_index = ReadLink(chunk_index);
+	}
+
+	if (chunk_index != NULL_INDEX)
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Open(std::span<std::byte>&&)]: Buffer doesnt have a valid free list.");
+
+		m_buffer = {};
+		m_chunk_size = 0u;
+		m_chunk_count = 0u;
+		m_link_size = 0u;
+		m_header = &m_local_header;
+	}
+}
+
 void* PoolAllocator::Allocate()
 {
-	// If theres no free chunks then cant allocate
-	if (m_free_list_head == nullptr)
+	unsigned chunk_index = m_header->m_free_list_head;
+	if (chunk_index != NULL_INDEX)
 	{
+		// Remove the chunk from the container with the free chunks
+		m_header->m_free_list_head = ReadLink(chunk_index);
+	}
+	else if (m_header->m_bump_index < GetChunkCount())
+	{
+		// Free list is empty, carve the next never used chunk
+		chunk_index = m_header->m_bump_index++;
+
+		// First chunk carved in its bitmap word, the word still holds whatever it had before
+		if (chunk_index % 64u == 0u)
+			m_occupancy_bitmap[chunk_index / 64u] = 0u;
+	}
+	else
+	{
+		// If theres no free chunks then cant allocate
 		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void* Allocate()]: No free chunks to allocate into.");
 		return nullptr;
 	}
 
-	// Remove the chunk from the container with the free chunks
-	std::byte* free_list_head_temp = m_free_list_head;
-	m_free_list_head = reinterpret_cast<PoolAllocationHeader*>(m_free_list_head)->m_free_list_next;
+	m_occupancy_bitmap[chunk_index / 64u] |= uint64_t(1u) << (chunk_index % 64u);
+	m_header->m_free_chunk_count--;
 
 	// Return a ptr to the allocated memory
-	return free_list_head_temp;
+	return GetChunk(chunk_index);
 }
 
 void PoolAllocator::Free(void* ptr)
@@ -56,30 +195,100 @@ void PoolAllocator::Free(void* ptr)
 	if (IsChunkFree(ptr))
 		return;
 
-	// Distance from ptr to buffer
-	ptrdiff_t ptr_buffer_dist = (std::byte*)ptr - m_buffer.data();
+	const unsigned chunk_index = GetChunkIndex(ptr);
+	m_occupancy_bitmap[chunk_index / 64u] &= ~(uint64_t(1u) << (chunk_index % 64u));
+	m_header->m_free_chunk_count++;
 
 	// Doesn't have to be sorted so we can just place the freed chunk at the start
-	new (ptr) PoolAllocationHeader(m_free_list_head);
-	m_free_list_head = static_cast<std::byte*>(ptr);
+	WriteLink(chunk_index, m_header->m_free_list_head);
+	m_header->m_free_list_head = chunk_index;
 }
 
-bool PoolAllocator::IsChunkFree(void* ptr) const
+unsigned PoolAllocator::AllocateN(std::span<void*> out)
 {
-	if (!IsChunkPtrValid(ptr) || m_free_list_head == ptr)
-		return true;
-	if (m_free_list_head == nullptr)
-		return false;
+	PoolHeader& header = *m_header;
+	const unsigned count = static_cast<unsigned>(std::min<size_t>(out.size(), header.m_free_chunk_count));
+	if (count < out.size())
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, unsigned AllocateN(std::span<void*>)]: Not enough free chunks to allocate them all.");
+
+	// The free list has every free chunk that isnt past the bump index
+	const unsigned free_list_length = header.m_free_chunk_count - (GetChunkCount() - header.m_bump_index);
+	const unsigned from_free_list = std::min(count, free_list_length);
+
+	// Detach the run from the front of the free list, only its chunks have to be visited
+	unsigned chunk_index = header.m_free_list_head;
+	for (unsigned i = 0u; i < from_free_list; i++)
+	{
+		out[i] = GetChunk(chunk_index);
+		m_occupancy_bitmap[chunk_index / 64u] |= uint64_t(1u) << (chunk_index % 64u);
+
+		chunk_index = ReadLink(chunk_index);
+	}
+	header.m_free_list_head = chunk_index;
+
+	// The rest are never used chunks, they are next to each other so there is nothing to read
+	const unsigned from_bump = count - from_free_list;
+	std::byte* bump_chunk = GetChunk(header.m_bump_index);
+	for (unsigned i = from_free_list; i < count; i++, bump_chunk += m_chunk_size)
+		out[i] = bump_chunk;
+
+	SetChunksAllocated(header.m_bump_index, from_bump);
+	header.m_bump_index += from_bump;
+	header.m_free_chunk_count -= count;
+
+	return count;
+}
+
+void PoolAllocator::FreeN(std::span<void* const> ptrs)
+{
+	// Every freed chunk links to the one freed before it and the first one to the free list, the head only changes once at the end
+	PoolHeader& header = *m_header;
+	unsigned run_head = header.m_free_list_head;
+	for (void* ptr : ptrs)
+	{
+		// If its already free then skip it, this also catches a ptr that is in ptrs twice
+		if (IsChunkFree(ptr))
+			continue;
 
-	// Check if the chunk is free by checking the headers of each free chunk
-	std::byte* it = m_free_list_head;
-	while (it != nullptr)
+		const unsigned chunk_index = GetChunkIndex(ptr);
+		m_occupancy_bitmap[chunk_index / 64u] &= ~(uint64_t(1u) << (chunk_index % 64u));
+		header.m_free_chunk_count++;
+
+		WriteLink(chunk_index, run_head);
+		run_head = chunk_index;
+	}
+
+	header.m_free_list_head = run_head;
+}
+
+void PoolAllocator::SetChunksAllocated(const unsigned& first_index, const unsigned& count)
+{
+	unsigned index = first_index;
+	const unsigned end_index = first_index + count;
+	while (index < end_index)
 	{
-		if (it == ptr)
-			return true;
-		it = reinterpret_cast<PoolAllocationHeader*>(it)->m_free_list_next;
+		// Bits of this word from index on, up to end_index
+		const unsigned bit = index % 64u;
+		const unsigned bit_count = std::min(64u - bit, end_index - index);
+		const uint64_t mask = (bit_count == 64u ? ~uint64_t(0u) : (uint64_t(1u) << bit_count) - 1u) << bit;
+
+		// A word the bump index is entering has never been written since the last Clear, its old bits are overwritten
+		if (bit == 0u)
+			m_occupancy_bitmap[index / 64u] = mask;
+		else
+			m_occupancy_bitmap[index / 64u] |= mask;
+		index += bit_count;
 	}
-	return false;
+}
+
+bool PoolAllocator::IsChunkFree(void* ptr) const
+{
+	if (!IsChunkPtrValid(ptr))
+		return true;
+
+	// No need to look through the free list, the bitmap has the state of every chunk that has been used
+	const unsigned chunk_index = GetChunkIndex(ptr);
+	return chunk_index >= m_header->m_bump_index || !(m_occupancy_bitmap[chunk_index / 64u] & (uint64_t(1u) << (chunk_index % 64u)));
 }
 
 bool PoolAllocator::IsChunkPtrValid(void* ptr) const
@@ -88,7 +297,7 @@ bool PoolAllocator::IsChunkPtrValid(void* ptr) const
 		return false;
 
 	// Check if the ptr is pointing somewhere inside the buffer
-	if (ptr < m_buffer.data() || ptr > m_buffer.data() + GetBufferSize())
+	if (ptr < m_buffer.data() || ptr >= m_buffer.data() + GetBufferSize())
 	{
 		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, bool IsChunkFree(void*)]: Ptr to deallocate was not in buffer.");
 		return false;
@@ -107,11 +316,34 @@ bool PoolAllocator::IsChunkPtrValid(void* ptr) const
 
 void PoolAllocator::Clear()
 {
-	// Resets all data and prepares for reuse without changing allocated memory
-	m_free_list_head = m_buffer.data();
-	
-	// Write header info for each chunk
-	for (unsigned i = 0u; i < m_buffer.size() / m_chunk_size - 1; i++)
-		new (&m_buffer[i * m_chunk_size]) PoolAllocationHeader(&m_buffer[(i + 1) * m_chunk_size]);
-	new (&m_buffer[(m_buffer.size() / m_chunk_size - 1) * m_chunk_size]) PoolAllocationHeader();
-}
\ No newline at end of file
+	// Resets all data and prepares for reuse without changing allocated memory, chunks are carved lazily by Allocate
+	m_header->m_free_list_head = NULL_INDEX;
+	m_header->m_bump_index = 0u;
+	m_header->m_free_chunk_count = GetChunkCount();
+}
+
+void PoolAllocator::Relocate(std::span<std::byte>&& memory_buffer)
+{
+	if (HasHeaderInBuffer())
+	{
+		if (!IsAligned(reinterpret_cast<uintptr_t>(memory_buffer.data()), alignof(PoolHeader)) || memory_buffer.size() < HEADER_SIZE + m_buffer.size())
+		{
+			debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Relocate(std::span<std::byte>&&)]: Buffer cannot fit the pool's header and chunks, or it isnt aligned to the header.");
+			return;
+		}
+
+		// The header was copied with the chunks, the pool keeps using it from the new buffer
+		m_header = reinterpret_cast<PoolHeader*>(memory_buffer.data());
+		m_buffer = memory_buffer.subspan(HEADER_SIZE, m_buffer.size());
+		return;
+	}
+
+	if (memory_buffer.size() != m_buffer.size())
+	{
+		debug_print("ERROR [PoolAllocator.cpp, PoolAllocator, void Relocate(std::span<std::byte>&&)]: Buffer size has to be the same as the pool's one.");
+		return;
+	}
+
+	// Links are indices, nothing in the buffer has to be fixed up
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+}
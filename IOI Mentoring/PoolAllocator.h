@@ -11,26 +11,84 @@
 class PoolAllocator : public IAllocator
 {
 public:
-	struct PoolAllocationHeader
+	// Free chunks link to the next one by index, with 16 bits if the pool has up to SMALL_POOL_CHUNK_COUNT chunks and 32 bits otherwise,
+	// so chunks can be as small as the link. The buffer holds no addresses, a pool can be copied somewhere else and used from there.
+	static constexpr unsigned NULL_INDEX = ~0u;
+	static constexpr unsigned SMALL_POOL_CHUNK_COUNT = 0xFFFFu;		// Index 0xFFFF is the null link of 16-bit links
+	static constexpr unsigned MAX_LINK_SIZE = sizeof(uint32_t);
+
+	// Smallest chunk a pool with the given amount of chunks can have
+	static unsigned GetMinChunkSize(const size_t& chunk_count)
 	{
-		PoolAllocationHeader(std::byte* free_list_next = nullptr) : m_free_list_next(free_list_next)
-		{	};
+		return chunk_count <= SMALL_POOL_CHUNK_COUNT ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
+	static constexpr unsigned CACHE_LINE_SIZE = 64u;
 
-		std::byte* m_free_list_next = nullptr;
+	// The state of the pool, only indices and sizes. Init keeps it in the pool, InitWithHeader at the front of the buffer so the buffer
+	// describes the whole pool.
+	struct PoolHeader
+	{
+		uint32_t m_magic = 0u;
+		uint32_t m_chunk_size = 0u;
+		uint32_t m_chunk_count = 0u;
+		uint32_t m_link_size = 0u;
+		uint32_t m_free_list_head = NULL_INDEX;		// Chunks that were allocated and freed again, the never used ones are not in it
+		uint32_t m_bump_index = 0u;
+		uint32_t m_free_chunk_count = 0u;
 	};
 
+	static constexpr uint32_t HEADER_MAGIC = 0x4C4F4F50u;		// "POOL"
+	static constexpr size_t HEADER_SIZE = 32u;					// Bytes before the first chunk with InitWithHeader
+	static_assert(sizeof(PoolHeader) <= HEADER_SIZE, "Pool header doesnt fit before the first chunk.");
+
+	PoolAllocator() = default;
+
+	// The pool can point at its own header, it cant be copied or moved
+	PoolAllocator(const PoolAllocator&) = delete;
+	PoolAllocator& operator=(const PoolAllocator&) = delete;
+
 	void Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes);
 
+	// Every chunk is aligned to alignment (a power of two), chunks are padded to a multiple of it and the buffer is trimmed to the
+	// first aligned address and a whole number of chunks. Isolated chunks take whole cache lines of their own, so objects used by
+	// different threads never share one (false sharing). GetChunkSize has the padded size.
+	void Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes, const size_t& alignment, const bool& isolated = false);
+
+	// Keeps the header in the first HEADER_SIZE bytes of the buffer and the chunks after it, the bytes after the last whole chunk are
+	// not used. The buffer has to be aligned to the header. A copy of the buffer (memcpy'd, saved to a file, mapped by another
+	// process) is a whole pool that Open can use, only one pool can use a buffer at a time.
+	void InitWithHeader(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes);
+
+	// Uses a buffer set up by InitWithHeader, or a copy of it, with the chunks it has allocated. The header and the free list are checked
+	// and the occupancy bitmap is rebuilt from them, O(chunks used). The pool is left without chunks if the buffer isnt valid.
+	void Open(std::span<std::byte>&& memory_buffer);
+
 	void* Allocate();
 
 	void Free(void* ptr);
 
+	// Fills out with as many chunks as there are free, up to its size, and returns how many. The run is detached from the front
+	// of the free list in one go and the rest is taken from the never used chunks, which are contiguous.
+	unsigned AllocateN(std::span<void*> out);
+
+	// Frees every chunk in ptrs, invalid ones and double frees are skipped. They are linked to each other and attached to the
+	// free list at once.
+	void FreeN(std::span<void* const> ptrs);
+
+	// O(1), looks the chunk up in the occupancy bitmap. Invalid ptrs count as free so they are never freed.
 	bool IsChunkFree(void* ptr) const;
 
 	bool IsChunkPtrValid(void* ptr) const;
 
 	void Clear();
 
+	// Points the pool at a copy of its buffer without changing its state. The free list links are indices so the copy needs no
+	// fixing up. With Init the rest of the state lives in this object, the copy has to be the same size and only this same pool can
+	// move to it. With a header the copy is of the whole buffer InitWithHeader got (header included, aligned like it) and any pool
+	// can Open it instead.
+	void Relocate(std::span<std::byte>&& memory_buffer);
+
 	size_t GetBufferSize() const
 	{
 		return m_buffer.size();
@@ -41,27 +99,103 @@ public:
 		return m_chunk_size;
 	}
 
-	// For debug & test purposes
 	unsigned GetFreeChunkAmount() const
 	{
-		if (m_free_list_head == nullptr)
-			return 0u;
+		return m_header->m_free_chunk_count;
+	}
+
+	// True if the state is in the buffer (InitWithHeader or Open)
+	bool HasHeaderInBuffer() const
+	{
+		return m_header != &m_local_header;
+	}
 
-		unsigned free_chunk_count = 0u;
-		std::byte* it = m_free_list_head;
-		while (it != nullptr)
+	// Calls fn with every allocated chunk in address order. It scans the occupancy bitmap a word at a time, so free chunks cost
+	// a bit each and the chunks are never read. fn may free the chunk it is given.
+	template <typename Fn>
+	void ForEachAllocatedChunk(Fn&& fn) const
+	{
+		// Only the words the bump index has entered, they are zeroed when it does so their bits past it are clear
+		for (unsigned word = 0u; word < (m_header->m_bump_index + 63u) / 64u; word++)
 		{
-			it = reinterpret_cast<PoolAllocationHeader*>(it)->m_free_list_next;
-			free_chunk_count++;
+			uint64_t bits = m_occupancy_bitmap[word];
+
+			while (bits != 0u)
+			{
+				const unsigned bit = static_cast<unsigned>(std::countr_zero(bits));
+				bits &= bits - 1u;
+				fn(static_cast<void*>(m_buffer.data() + static_cast<size_t>(word * 64u + bit) * m_chunk_size));
+			}
 		}
-		return free_chunk_count;
+	}
+
+	unsigned GetChunkCount() const
+	{
+		return m_chunk_count;
+	}
+
+	// Index of the chunk the ptr points into, the ptr has to be in the buffer
+	unsigned GetChunkIndex(const void* ptr) const
+	{
+		return static_cast<unsigned>((static_cast<const std::byte*>(ptr) - m_buffer.data()) / m_chunk_size);
 	}
 
 private:
+	// Checks the chunk size against the buffer and sets everything but the header, returns false if they cant be used
+	bool InitBuffer(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes);
+
+	// Sets the occupancy bits of count chunks from first_index on, a word at a time. first_index is the bump index, the chunks are
+	// being carved.
+	void SetChunksAllocated(const unsigned& first_index, const unsigned& count);
+
 	std::span<std::byte> m_buffer{};
 	unsigned m_chunk_size = 0u;
+	unsigned m_chunk_count = 0u;		// Stays 0 until an Init succeeds, so a pool without chunks never divides by the chunk size
+
+	std::byte* GetChunk(const unsigned& chunk_index) const
+	{
+		return m_buffer.data() + static_cast<size_t>(chunk_index) * m_chunk_size;
+	}
+
+	// Links are copied byte by byte as chunks of odd sizes leave them unaligned
+	unsigned ReadLink(const unsigned& chunk_index) const
+	{
+		if (m_link_size == sizeof(uint16_t))
+		{
+			uint16_t link;
+			std::memcpy(&link, GetChunk(chunk_index), sizeof(link));
+			return link == SMALL_POOL_CHUNK_COUNT ? NULL_INDEX : link;
+		}
+
+		uint32_t link;
+		std::memcpy(&link, GetChunk(chunk_index), sizeof(link));
+		return link;
+	}
+
+	void WriteLink(const unsigned& chunk_index, const unsigned& next_index)
+	{
+		if (m_link_size == sizeof(uint16_t))
+		{
+			const uint16_t link = static_cast<uint16_t>(next_index);
+			std::memcpy(GetChunk(chunk_index), &link, sizeof(link));
+			return;
+		}
+
+		const uint32_t link = next_index;
+		std::memcpy(GetChunk(chunk_index), &link, sizeof(link));
+	}
+
+	unsigned m_link_size = 0u;
+
+	// Has the free list head, the bump index and the free chunk count. Chunks from the bump index on have never been allocated since
+	// the last Clear, they are handed out in order once the free list is empty. Their memory is never written to until then, so Init &
+	// Clear are O(1) and the pages are only touched when first used.
+	PoolHeader m_local_header{};
+	PoolHeader* m_header = &m_local_header;
 
-	std::byte* m_free_list_head = nullptr;		// we could make this an unsigned for distance from start of buffer
+	// One bit per chunk, set while it is allocated. It lives outside the buffer so the chunks keep all their bytes. It is left
+	// uninitialized and is not reset by Clear, each word is zeroed when the bump index first enters it instead.
+	std::unique_ptr<uint64_t[]> m_occupancy_bitmap;
 };
 
 
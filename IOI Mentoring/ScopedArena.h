@@ -0,0 +1,43 @@
+/***************************************************************************//**
+ * @filename ScopedArena.h
+ * @brief	 Contains the scoped arena class, which rewinds a marker based
+ *			 allocator when it goes out of scope.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+
+// Takes a marker from the allocator on construction and frees back to it on destruction, so everything allocated in the scope
+// (through the arena or straight from the allocator) goes at once. Scopes can be nested as long as they are destroyed in order.
+// Works with any allocator that has GetMarker and FreeToMarker, the linear and stack allocators.
+template <typename Allocator>
+class ScopedArena
+{
+public:
+	explicit ScopedArena(Allocator& allocator) : m_allocator(allocator), m_marker(allocator.GetMarker())
+	{	}
+
+	~ScopedArena()
+	{
+		m_allocator.FreeToMarker(m_marker);
+	}
+
+	ScopedArena(const ScopedArena&) = delete;
+	ScopedArena& operator=(const ScopedArena&) = delete;
+
+	template <typename... Args>
+	void* Allocate(Args&&... args)
+	{
+		return m_allocator.Allocate(std::forward<Args>(args)...);
+	}
+
+	typename Allocator::Marker GetMarker() const
+	{
+		return m_marker;
+	}
+
+private:
+	Allocator& m_allocator;
+	const typename Allocator::Marker m_marker;
+};
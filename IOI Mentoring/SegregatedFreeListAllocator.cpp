@@ -0,0 +1,248 @@
+/***************************************************************************//**
+ * @filename SegregatedFreeListAllocator.cpp
+ * @brief	 Contains the segregated fit free list allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "SegregatedFreeListAllocator.h"
+
+constexpr unsigned SIZE_ALLOC_HEADER = sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+constexpr unsigned SIZE_FREE_HEADER = sizeof(SegregatedFreeListAllocator::SegregatedFreeHeader);
+constexpr unsigned SIZE_FREE_FOOTER = sizeof(SegregatedFreeListAllocator::FreeListFreeFooter);
+
+// Smallest chunk (headers included) that can be labelled as free
+constexpr unsigned MIN_FREE_CHUNK_SIZE = SIZE_FREE_HEADER + SIZE_FREE_FOOTER;
+
+void SegregatedFreeListAllocator::Init(std::span<std::byte>&& memory_buffer)
+{
+	// Safety check, buffer size cant be less than a free chunk
+	if (memory_buffer.size() < MIN_FREE_CHUNK_SIZE)
+	{
+		debug_print("ERROR [SegregatedFreeListAllocator.cpp, SegregatedFreeListAllocator, void Init(std::span<std::byte>&&)]: Buffer size cannot be less than a free chunk (16 bytes).");
+		assert(0);
+	}
+
+	// The top bits of the chunk sizes are used as flags
+	if (memory_buffer.size() - SIZE_ALLOC_HEADER > SIZE_MASK)
+	{
+		debug_print("ERROR [SegregatedFreeListAllocator.cpp, SegregatedFreeListAllocator, void Init(std::span<std::byte>&&)]: Buffer size cannot be larger than 1 GiB.");
+		assert(0);
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+
+	Clear();
+}
+
+void SegregatedFreeListAllocator::MappingInsert(const unsigned& size_in_bytes, unsigned& fl, unsigned& sl)
+{
+	// Small sizes get a bin each
+	if (size_in_bytes < SMALL_CHUNK_SIZE)
+	{
+		fl = 0u;
+		sl = size_in_bytes;
+		return;
+	}
+
+	// The first level is the power of two, the second level the next SL_COUNT_LOG2 bits after the most significant one
+	const unsigned fl_log2 = static_cast<unsigned>(std::bit_width(size_in_bytes)) - 1u;
+	sl = (size_in_bytes >> (fl_log2 - SL_COUNT_LOG2)) ^ SL_COUNT;
+	fl = fl_log2 - SL_COUNT_LOG2 + 1u;
+}
+
+void SegregatedFreeListAllocator::MappingSearch(unsigned size_in_bytes, unsigned& fl, unsigned& sl)
+{
+	// Round up to the next bin so any chunk in the bin we land on is large enough, this is what makes the search a bit scan
+	if (size_in_bytes >= SMALL_CHUNK_SIZE)
+		size_in_bytes += (1u << (std::bit_width(size_in_bytes) - 1u - SL_COUNT_LOG2)) - 1u;
+
+	MappingInsert(size_in_bytes, fl, sl);
+}
+
+void SegregatedFreeListAllocator::InsertFreeChunk(SegregatedFreeHeader* chunk)
+{
+	unsigned fl, sl;
+	MappingInsert(chunk->m_chunk_size, fl, sl);
+
+	// Push at the front of its bin
+	chunk->m_bin_prev = NULL_OFFSET;
+	chunk->m_bin_next = m_bins[fl][sl];
+	if (chunk->m_bin_next != NULL_OFFSET)
+		ToChunk(chunk->m_bin_next)->m_bin_prev = ToOffset(chunk);
+	m_bins[fl][sl] = ToOffset(chunk);
+
+	m_fl_bitmap |= 1u << fl;
+	m_sl_bitmaps[fl] |= 1u << sl;
+}
+
+void SegregatedFreeListAllocator::RemoveFreeChunk(SegregatedFreeHeader* chunk)
+{
+	unsigned fl, sl;
+	MappingInsert(chunk->m_chunk_size, fl, sl);
+
+	if (chunk->m_bin_prev != NULL_OFFSET)
+		ToChunk(chunk->m_bin_prev)->m_bin_next = chunk->m_bin_next;
+	else
+		m_bins[fl][sl] = chunk->m_bin_next;
+
+	if (chunk->m_bin_next != NULL_OFFSET)
+		ToChunk(chunk->m_bin_next)->m_bin_prev = chunk->m_bin_prev;
+
+	// If the bin is now empty update the bitmaps
+	if (m_bins[fl][sl] == NULL_OFFSET)
+	{
+		m_sl_bitmaps[fl] &= ~(1u << sl);
+		if (m_sl_bitmaps[fl] == 0u)
+			m_fl_bitmap &= ~(1u << fl);
+	}
+}
+
+SegregatedFreeListAllocator::SegregatedFreeHeader* SegregatedFreeListAllocator::FindFreeChunk(unsigned size_in_bytes) const
+{
+	unsigned fl, sl;
+	MappingSearch(size_in_bytes, fl, sl);
+
+	if (fl >= FL_COUNT)
+		return nullptr;
+
+	// First look for a non empty bin in the same power of two, otherwise go to the next non empty power of two
+	unsigned sl_map = m_sl_bitmaps[fl] & (~0u << sl);
+	if (sl_map == 0u)
+	{
+		const unsigned fl_map = fl + 1u < 32u ? m_fl_bitmap & (~0u << (fl + 1u)) : 0u;
+		if (fl_map == 0u)
+			return nullptr;
+
+		fl = static_cast<unsigned>(std::countr_zero(fl_map));
+		sl_map = m_sl_bitmaps[fl];
+	}
+	sl = static_cast<unsigned>(std::countr_zero(sl_map));
+
+	return ToChunk(m_bins[fl][sl]);
+}
+
+SegregatedFreeListAllocator::FreeListAllocHeader* SegregatedFreeListAllocator::GetNextChunk(const void* chunk) const
+{
+	// Same chunks as the free list allocator with plain byte sizes
+	return FreeListAllocatorBase::GetNextChunk(m_buffer, chunk, 0u, 0u);
+}
+
+void* SegregatedFreeListAllocator::Allocate(unsigned size_in_bytes)
+{
+	if (size_in_bytes == 0u)
+		return nullptr;
+
+	// Once freed, the chunk has to be able to hold the free header and footer
+	if (size_in_bytes + SIZE_ALLOC_HEADER < MIN_FREE_CHUNK_SIZE)
+		size_in_bytes = MIN_FREE_CHUNK_SIZE - SIZE_ALLOC_HEADER;
+
+	if (size_in_bytes > SIZE_MASK)
+		return nullptr;
+
+	SegregatedFreeHeader* free_chunk = FindFreeChunk(size_in_bytes);
+	if (free_chunk == nullptr)
+		return nullptr;
+
+	RemoveFreeChunk(free_chunk);
+
+	// Create a free chunk with the remaining memory if it is large enough, otherwise extend the allocated chunk
+	if (free_chunk->m_chunk_size - size_in_bytes >= MIN_FREE_CHUNK_SIZE)
+	{
+		SegregatedFreeHeader* remaining_chunk = new (reinterpret_cast<std::byte*>(free_chunk) + SIZE_ALLOC_HEADER + size_in_bytes)
+												SegregatedFreeHeader(free_chunk->m_chunk_size - size_in_bytes - SIZE_ALLOC_HEADER);
+		new (reinterpret_cast<std::byte*>(remaining_chunk) + SIZE_ALLOC_HEADER + remaining_chunk->m_chunk_size - SIZE_FREE_FOOTER)
+			FreeListFreeFooter(remaining_chunk->m_chunk_size);
+		InsertFreeChunk(remaining_chunk);
+	}
+	else
+	{
+		size_in_bytes = free_chunk->m_chunk_size;
+
+		// The next chunk no longer has a free neighbour behind it
+		if (FreeListAllocHeader* next_chunk = GetNextChunk(free_chunk))
+			next_chunk->m_chunk_size &= ~FLAG_PREV_FREE;
+	}
+
+	// Free chunks never have a free previous chunk as they would have been merged
+	return reinterpret_cast<std::byte*>(new (free_chunk) FreeListAllocHeader(size_in_bytes | FLAG_IN_USE)) + SIZE_ALLOC_HEADER;
+}
+
+void SegregatedFreeListAllocator::Free(void* ptr)
+{
+	// Move the ptr to the start of the alloc chunk, make it point to the header
+	ptr = static_cast<std::byte*>(ptr) - SIZE_ALLOC_HEADER;
+
+	if (!IsChunkPtrValid(ptr))
+		return;
+
+	const unsigned chunk_header = reinterpret_cast<FreeListAllocHeader*>(ptr)->m_chunk_size;
+	std::byte* chunk_start = static_cast<std::byte*>(ptr);
+	unsigned chunk_size = chunk_header & SIZE_MASK;
+
+	// Merge forward, the next chunk's header tells us if it is free
+	FreeListAllocHeader* next_chunk = GetNextChunk(ptr);
+	if (next_chunk != nullptr && !(next_chunk->m_chunk_size & FLAG_IN_USE))
+	{
+		SegregatedFreeHeader* next_free_chunk = reinterpret_cast<SegregatedFreeHeader*>(next_chunk);
+		RemoveFreeChunk(next_free_chunk);
+		chunk_size += next_free_chunk->m_chunk_size + SIZE_ALLOC_HEADER;
+	}
+
+	// Merge backwards, the previous chunk's footer tells us where it starts
+	if (chunk_header & FLAG_PREV_FREE)
+	{
+		const unsigned prev_chunk_size = reinterpret_cast<FreeListFreeFooter*>(chunk_start - SIZE_FREE_FOOTER)->m_chunk_size;
+		SegregatedFreeHeader* prev_free_chunk = reinterpret_cast<SegregatedFreeHeader*>(chunk_start - prev_chunk_size - SIZE_ALLOC_HEADER);
+		RemoveFreeChunk(prev_free_chunk);
+		chunk_size += prev_chunk_size + SIZE_ALLOC_HEADER;
+
+		// Our alloc header is now in the middle of a free chunk, clear it so freeing the ptr again is caught
+		reinterpret_cast<FreeListAllocHeader*>(chunk_start)->m_chunk_size = 0u;
+		chunk_start = reinterpret_cast<std::byte*>(prev_free_chunk);
+	}
+
+	SegregatedFreeHeader* new_free_chunk = new (chunk_start) SegregatedFreeHeader(chunk_size);
+	new (chunk_start + SIZE_ALLOC_HEADER + chunk_size - SIZE_FREE_FOOTER) FreeListFreeFooter(chunk_size);
+	InsertFreeChunk(new_free_chunk);
+
+	// Let the next chunk know it now has a free neighbour behind it
+	if (FreeListAllocHeader* new_next_chunk = GetNextChunk(new_free_chunk))
+		new_next_chunk->m_chunk_size |= FLAG_PREV_FREE;
+}
+
+// Check if the ptr points outside the buffer, doesnt point to an allocated chunk or is nullptr
+bool SegregatedFreeListAllocator::IsChunkPtrValid(void* ptr) const
+{
+	return FreeListAllocatorBase::IsAllocChunkValid(m_buffer, ptr, 0u, 0u);
+}
+
+std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> SegregatedFreeListAllocator::GetFreeChunks() const
+{
+	std::list<SegregatedFreeHeader*> result;
+	std::byte* it = m_buffer.data();
+	while (it != nullptr)
+	{
+		if (!(reinterpret_cast<FreeListAllocHeader*>(it)->m_chunk_size & FLAG_IN_USE))
+			result.push_back(reinterpret_cast<SegregatedFreeHeader*>(it));
+
+		it = reinterpret_cast<std::byte*>(GetNextChunk(it));
+	}
+
+	return result;
+}
+
+void SegregatedFreeListAllocator::Clear()
+{
+	m_fl_bitmap = 0u;
+	m_sl_bitmaps.fill(0u);
+	for (std::array<unsigned, SL_COUNT>& fl_bins : m_bins)
+		fl_bins.fill(NULL_OFFSET);
+
+	// Initialize free chunks, only chunk we have is the entire buffer
+	const unsigned chunk_size = static_cast<unsigned>(m_buffer.size()) - SIZE_ALLOC_HEADER;
+	SegregatedFreeHeader* chunk = new (&m_buffer[0]) SegregatedFreeHeader(chunk_size);
+	new (&m_buffer[SIZE_ALLOC_HEADER + chunk_size - SIZE_FREE_FOOTER]) FreeListFreeFooter(chunk_size);
+	InsertFreeChunk(chunk);
+}
@@ -0,0 +1,92 @@
+/***************************************************************************//**
+ * @filename SegregatedFreeListAllocator.h
+ * @brief	 Contains the segregated fit (TLSF style) free list allocator class
+ *			 header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "FreeListAllocator.h"
+
+// Free chunks are kept in size class bins, a first level per power of two and a second level that splits each power of two
+// into SL_COUNT equal ranges. Two levels of bitmaps tell us which bins have chunks, so finding a chunk is a couple of bit scans.
+class SegregatedFreeListAllocator : public IAllocator
+{
+public:
+	// Allocated chunks use the same header as the free list allocator
+	using FreeListAllocHeader = FreeListAllocator::FreeListAllocHeader;
+
+	// Offsets are distances from the start of the buffer, this keeps the free header as small as the free list allocator's one
+	struct SegregatedFreeHeader
+	{
+		SegregatedFreeHeader(const unsigned& chunk_size = 0u, const unsigned& bin_next = NULL_OFFSET, const unsigned& bin_prev = NULL_OFFSET) :
+			m_chunk_size(chunk_size), m_bin_next(bin_next), m_bin_prev(bin_prev)
+		{	}
+
+		unsigned m_chunk_size = 0u;				// Has to be the first member, it overlaps FreeListAllocHeader::m_chunk_size
+		unsigned m_bin_next = NULL_OFFSET;
+		unsigned m_bin_prev = NULL_OFFSET;
+	};
+
+	// Boundary tags are the same as the free list allocator's ones
+	using FreeListFreeFooter = FreeListAllocator::FreeListFreeFooter;
+
+	static constexpr unsigned NULL_OFFSET = FreeListAllocator::NULL_OFFSET;
+
+	static constexpr unsigned FLAG_IN_USE = FreeListAllocator::FLAG_IN_USE;
+	static constexpr unsigned FLAG_PREV_FREE = FreeListAllocator::FLAG_PREV_FREE;
+	static constexpr unsigned SIZE_MASK = FreeListAllocator::SIZE_MASK;
+
+	static constexpr unsigned SL_COUNT_LOG2 = 4u;
+	static constexpr unsigned SL_COUNT = 1u << SL_COUNT_LOG2;
+	static constexpr unsigned FL_COUNT = 32u - SL_COUNT_LOG2 + 1u;
+	static constexpr unsigned SMALL_CHUNK_SIZE = SL_COUNT;		// Sizes below this all go in the first level 0 bins, one bin per size
+
+	void Init(std::span<std::byte>&& memory_buffer);
+
+	void* Allocate(unsigned size_in_bytes);
+
+	void Free(void* ptr);
+
+	void Clear();
+
+	bool IsChunkPtrValid(void* ptr) const;
+
+	size_t GetBufferSize() const
+	{
+		return m_buffer.size();
+	}
+
+	// For debug & test purposes, walks the whole buffer so the chunks are in address order
+	std::list<SegregatedFreeHeader*> GetFreeChunks() const;
+
+private:
+	void InsertFreeChunk(SegregatedFreeHeader* chunk);
+	void RemoveFreeChunk(SegregatedFreeHeader* chunk);
+
+	SegregatedFreeHeader* FindFreeChunk(unsigned size_in_bytes) const;
+
+	static void MappingInsert(const unsigned& size_in_bytes, unsigned& fl, unsigned& sl);
+	static void MappingSearch(unsigned size_in_bytes, unsigned& fl, unsigned& sl);
+
+	SegregatedFreeHeader* ToChunk(const unsigned& offset) const
+	{
+		return offset == NULL_OFFSET ? nullptr : reinterpret_cast<SegregatedFreeHeader*>(m_buffer.data() + offset);
+	}
+
+	unsigned ToOffset(const void* chunk) const
+	{
+		return chunk == nullptr ? NULL_OFFSET : static_cast<unsigned>(static_cast<const std::byte*>(chunk) - m_buffer.data());
+	}
+
+	// Returns the chunk physically after the given one, nullptr if the given one is the last chunk of the buffer
+	FreeListAllocHeader* GetNextChunk(const void* chunk) const;
+
+	unsigned m_fl_bitmap = 0u;
+	std::array<unsigned, FL_COUNT> m_sl_bitmaps{};
+	std::array<std::array<unsigned, SL_COUNT>, FL_COUNT> m_bins{};		// Offset to the first free chunk of each bin
+
+	std::span<std::byte> m_buffer{};
+};
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @filename SizeClassAllocator.cpp
+ * @brief	 Contains the size class small object allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "SizeClassAllocator.h"
+
+static_assert(SizeClassAllocator::MIN_SIZE_CLASS << (SizeClassAllocator::SIZE_CLASS_COUNT - 1u) == SizeClassAllocator::MAX_SIZE_CLASS);
+
+void SizeClassAllocator::Init(std::span<std::byte>&& memory_buffer)
+{
+	// Regions are a multiple of the largest class so every class divides its region
+	const size_t region_size = memory_buffer.size() / SIZE_CLASS_COUNT / MAX_SIZE_CLASS * MAX_SIZE_CLASS;
+	if (region_size == 0u)
+	{
+		debug_print("ERROR [SizeClassAllocator.cpp, SizeClassAllocator, void Init(std::span<std::byte>&&)]: Buffer size cannot be less than 4096 bytes per size class (40 KiB).");
+		return;
+	}
+
+	m_buffer = std::forward<std::span<std::byte>>(memory_buffer);
+	m_region_size = region_size;
+
+	// Pools carve their chunks lazily so this doesnt touch the buffer
+	for (unsigned i = 0u; i < SIZE_CLASS_COUNT; i++)
+		m_pools[i].Init(m_buffer.subspan(i * m_region_size, m_region_size), GetSizeClassSize(i));
+}
+
+void* SizeClassAllocator::Allocate(const unsigned& size_in_bytes)
+{
+	const unsigned size_class = GetSizeClass(size_in_bytes);
+	if (size_in_bytes == 0u || size_class == SIZE_CLASS_COUNT)
+	{
+		debug_print("ERROR [SizeClassAllocator.cpp, SizeClassAllocator, void* Allocate(const unsigned&)]: Allocation size has to be between 1 and 4096 bytes.");
+		return nullptr;
+	}
+
+	// Move up a class if this one is full, the pool reports every failed allocation so check before asking
+	for (unsigned i = size_class; i < SIZE_CLASS_COUNT; i++)
+		if (m_pools[i].GetFreeChunkAmount() != 0u)
+			return m_pools[i].Allocate();
+
+	debug_print("ERROR [SizeClassAllocator.cpp, SizeClassAllocator, void* Allocate(const unsigned&)]: No free chunks in this size class or any larger one.");
+	return nullptr;
+}
+
+void SizeClassAllocator::Free(void* ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	// No header, the region tells us the class
+	const unsigned region = GetRegion(ptr);
+	if (region == SIZE_CLASS_COUNT)
+	{
+		debug_print("ERROR [SizeClassAllocator.cpp, SizeClassAllocator, void Free(void*)]: Ptr to deallocate was not in buffer.");
+		return;
+	}
+
+	m_pools[region].Free(ptr);
+}
+
+bool SizeClassAllocator::IsChunkFree(void* ptr) const
+{
+	const unsigned region = GetRegion(ptr);
+	return region == SIZE_CLASS_COUNT || m_pools[region].IsChunkFree(ptr);
+}
+
+bool SizeClassAllocator::IsChunkPtrValid(void* ptr) const
+{
+	const unsigned region = GetRegion(ptr);
+	return region != SIZE_CLASS_COUNT && m_pools[region].IsChunkPtrValid(ptr);
+}
+
+size_t SizeClassAllocator::GetAllocationSize(void* ptr) const
+{
+	return IsChunkPtrValid(ptr) ? GetSizeClassSize(GetRegion(ptr)) : 0u;
+}
+
+void SizeClassAllocator::Clear()
+{
+	for (PoolAllocator& pool : m_pools)
+		pool.Clear();
+}
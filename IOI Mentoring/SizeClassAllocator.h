@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @filename SizeClassAllocator.h
+ * @brief	 Contains the size class small object allocator class header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "PoolAllocator.h"
+
+// Small object allocator made of one pool per power of two size class, from 8 to 4096 bytes. The buffer is split into equal regions,
+// one per class, so the class a chunk belongs to is found from its address and chunks dont need a header. Sizes are mapped to their
+// class with a lookup table. When a class runs out its allocations go to the next larger class that has room.
+class SizeClassAllocator : public IAllocator
+{
+public:
+	static constexpr unsigned MIN_SIZE_CLASS = 8u;
+	static constexpr unsigned MAX_SIZE_CLASS = 4096u;
+	static constexpr unsigned SIZE_CLASS_COUNT = 10u;		// 8, 16, 32 ... 4096
+
+	// The lookup table has an entry per LOOKUP_GRANULARITY bytes, so it is only MAX_SIZE_CLASS / MIN_SIZE_CLASS entries
+	static constexpr unsigned LOOKUP_GRANULARITY = MIN_SIZE_CLASS;
+
+	void Init(std::span<std::byte>&& memory_buffer);
+
+	// nullptr for 0 and sizes above MAX_SIZE_CLASS
+	void* Allocate(const unsigned& size_in_bytes);
+
+	void Free(void* ptr);
+
+	// Invalid ptrs count as free so they are never freed
+	bool IsChunkFree(void* ptr) const;
+
+	bool IsChunkPtrValid(void* ptr) const;
+
+	void Clear();
+
+	size_t GetBufferSize() const
+	{
+		return m_buffer.size();
+	}
+
+	size_t GetRegionSize() const
+	{
+		return m_region_size;
+	}
+
+	// Size class an allocation of the given size goes to, SIZE_CLASS_COUNT if it is too large
+	static unsigned GetSizeClass(const unsigned& size_in_bytes)
+	{
+		return size_in_bytes <= MAX_SIZE_CLASS ? SIZE_CLASS_LOOKUP[(size_in_bytes + LOOKUP_GRANULARITY - 1u) / LOOKUP_GRANULARITY] : SIZE_CLASS_COUNT;
+	}
+
+	static unsigned GetSizeClassSize(const unsigned& size_class)
+	{
+		return MIN_SIZE_CLASS << size_class;
+	}
+
+	// Usable bytes of the chunk the ptr points to, its class size. 0 if ptr isnt valid.
+	size_t GetAllocationSize(void* ptr) const;
+
+	unsigned GetFreeChunkAmount(const unsigned& size_class) const
+	{
+		return m_pools[size_class].GetFreeChunkAmount();
+	}
+
+private:
+	static constexpr std::array<uint8_t, MAX_SIZE_CLASS / LOOKUP_GRANULARITY + 1u> SIZE_CLASS_LOOKUP = []()
+		{
+			// Entry i has the smallest class that fits i * LOOKUP_GRANULARITY bytes, 0 bytes go in the smallest class too
+			std::array<uint8_t, MAX_SIZE_CLASS / LOOKUP_GRANULARITY + 1u> lookup{};
+			for (unsigned i = 1u; i < lookup.size(); i++)
+				lookup[i] = static_cast<uint8_t>(std::bit_width((i * LOOKUP_GRANULARITY - 1u) / MIN_SIZE_CLASS));
+			return lookup;
+		}();
+
+	// Region the ptr is in, SIZE_CLASS_COUNT if it isnt in the buffer
+	unsigned GetRegion(const void* ptr) const
+	{
+		if (ptr < m_buffer.data() || ptr >= m_buffer.data() + m_region_size * SIZE_CLASS_COUNT)
+			return SIZE_CLASS_COUNT;
+
+		return static_cast<unsigned>(static_cast<size_t>(static_cast<const std::byte*>(ptr) - m_buffer.data()) / m_region_size);
+	}
+
+	std::array<PoolAllocator, SIZE_CLASS_COUNT> m_pools;
+	size_t m_region_size = 0u;
+
+	std::span<std::byte> m_buffer{};
+};
@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ * @filename SlabSource.h
+ * @brief	 Contains the slab source interface and the slab sources growable
+ *			 allocators take their memory from.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "FreeListAllocator.h"
+
+// Where a growable allocator takes its slabs from and gives them back to. Slabs are aligned to the given alignment, a power of two.
+class ISlabSource
+{
+public:
+	virtual ~ISlabSource() = default;
+
+	// nullptr if there is no memory left
+	virtual void* AllocateSlab(const size_t& size_in_bytes, const size_t& alignment) = 0;
+	virtual void FreeSlab(void* slab, const size_t& size_in_bytes, const size_t& alignment) = 0;
+};
+
+// Slabs from the system heap
+class HeapSlabSource : public ISlabSource
+{
+public:
+	// Stateless, every allocator that doesnt get a source uses this one
+	static HeapSlabSource& Get()
+	{
+		static HeapSlabSource heap_slab_source;
+		return heap_slab_source;
+	}
+
+	void* AllocateSlab(const size_t& size_in_bytes, const size_t& alignment) override
+	{
+		return ::operator new(size_in_bytes, std::align_val_t(alignment), std::nothrow);
+	}
+
+	void FreeSlab(void* slab, const size_t&, const size_t& alignment) override
+	{
+		::operator delete(slab, std::align_val_t(alignment));
+	}
+};
+
+// Slabs carved from another allocator's buffer, so a growable allocator can share a budget with others
+class FreeListSlabSource : public ISlabSource
+{
+public:
+	FreeListSlabSource(FreeListAllocator& allocator) : m_allocator(allocator)
+	{	}
+
+	void* AllocateSlab(const size_t& size_in_bytes, const size_t& alignment) override
+	{
+		return m_allocator.Allocate(size_in_bytes, alignment);
+	}
+
+	void FreeSlab(void* slab, const size_t&, const size_t&) override
+	{
+		m_allocator.Free(slab);
+	}
+
+private:
+	FreeListAllocator& m_allocator;
+};
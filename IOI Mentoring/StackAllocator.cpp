@@ -21,42 +21,151 @@ void StackAllocator::Init(std::span<std::byte>&& memory_buffer)
 }
 
 void* StackAllocator::Allocate(size_t size_in_bytes, const size_t& alignment)
+{
+	if (alignment != 0u && !std::has_single_bit(alignment))
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* Allocate(size_t, const size_t&)]: Alignment has to be a power of two.");
+		return nullptr;
+	}
+
+	const size_t padding = alignment != 0u ? CalculatePadding(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset, alignment) : 0u;
+
+	return AllocateWithPadding(size_in_bytes, padding, true);
+}
+
+void* StackAllocator::AllocateWithoutFooter(size_t size_in_bytes, const size_t& alignment)
+{
+	if (alignment != 0u && !std::has_single_bit(alignment))
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateWithoutFooter(size_t, const size_t&)]: Alignment has to be a power of two.");
+		return nullptr;
+	}
+
+	const size_t padding = alignment != 0u ? CalculatePadding(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset, alignment) : 0u;
+
+	return AllocateWithPadding(size_in_bytes, padding, false);
+}
+
+void* StackAllocator::AllocateWithPadding(const size_t& size_in_bytes, const size_t& padding, const bool& footer)
 {
 	if (size_in_bytes == 0)
 	{
-		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* Allocate(size_t, const size_t&)]: Allocation size cannot be zero.");
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateWithPadding(const size_t&, const size_t&, const bool&)]: Allocation size cannot be zero.");
 		return nullptr;
 	}
 
-	size_in_bytes += sizeof(StackAllocationFooter);
-	if (alignment != 0)
-		size_in_bytes += CalculatePadding(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset + size_in_bytes, alignment);
+	const size_t total_size = padding + size_in_bytes + (footer ? sizeof(StackAllocationFooter) : 0u);
 
 	// If the requested size cannot be allocated then dont attempt
-	if (m_offset + size_in_bytes > m_buffer.size())
+	if (total_size > m_buffer.size() - m_offset - m_top_offset)
 	{
-		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* Allocate(size_t, const size_t&)]: Allocation is too large for remaining buffer.");
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateWithPadding(const size_t&, const size_t&, const bool&)]: Allocation is too large for remaining buffer.");
 		return nullptr;
 	}
 
 	// Update the offset and headers stack for the new block of memory
-	m_offset += size_in_bytes;
-	
-	// I could get rid of a copy here by moving alloc_size, but it the code would look horrible when returning, not sure what is better...
-	new (&m_buffer[m_offset - sizeof(StackAllocationFooter)]) StackAllocationFooter(size_in_bytes);
+	std::byte* block = m_buffer.data() + m_offset + padding;
+	m_offset += total_size;
+
+	// Free pops the padding together with the block
+	if (footer)
+		new (&m_buffer[m_offset - sizeof(StackAllocationFooter)]) StackAllocationFooter(total_size);
 
 	// Return pointer to allocated block
-	return &m_buffer[m_offset - size_in_bytes];
+	return block;
 }
 
 void StackAllocator::Free()
 {
 	// Decrease offset by the size of the last allocated block (read the size from the footer) in order to "free" it
-	if (m_offset - sizeof(StackAllocationFooter) >= 0u)
+	if (m_offset >= sizeof(StackAllocationFooter))
 		m_offset -= reinterpret_cast<StackAllocationFooter*>(m_buffer.data() + m_offset - sizeof(StackAllocationFooter))->m_alloc_size;	
 }
 
+void* StackAllocator::AllocateTop(size_t size_in_bytes, const size_t& alignment)
+{
+	return AllocateTopWithAlignment(size_in_bytes, alignment, true);
+}
+
+void* StackAllocator::AllocateTopWithoutFooter(size_t size_in_bytes, const size_t& alignment)
+{
+	return AllocateTopWithAlignment(size_in_bytes, alignment, false);
+}
+
+void* StackAllocator::AllocateTopWithAlignment(const size_t& size_in_bytes, const size_t& alignment, const bool& footer)
+{
+	if (size_in_bytes == 0)
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateTopWithAlignment(const size_t&, const size_t&, const bool&)]: Allocation size cannot be zero.");
+		return nullptr;
+	}
+
+	if (alignment != 0u && !std::has_single_bit(alignment))
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateTopWithAlignment(const size_t&, const size_t&, const bool&)]: Alignment has to be a power of two.");
+		return nullptr;
+	}
+
+	const size_t footer_size = footer ? sizeof(StackAllocationFooter) : 0u;
+	const size_t free_size = m_buffer.size() - m_offset - m_top_offset;
+	if (size_in_bytes + footer_size > free_size)
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateTopWithAlignment(const size_t&, const size_t&, const bool&)]: Allocation is too large for remaining buffer.");
+		return nullptr;
+	}
+
+	// Round the block down, whatever is left between it and the previous top allocation is the padding
+	const uintptr_t top = reinterpret_cast<uintptr_t>(m_buffer.data()) + m_buffer.size() - m_top_offset;
+	uintptr_t block = top - size_in_bytes;
+	if (alignment != 0u)
+		block &= ~static_cast<uintptr_t>(alignment - 1u);
+
+	const size_t total_size = static_cast<size_t>(top - block) + footer_size;
+	if (total_size > free_size)
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void* AllocateTopWithAlignment(const size_t&, const size_t&, const bool&)]: Allocation is too large for remaining buffer.");
+		return nullptr;
+	}
+
+	m_top_offset += total_size;
+
+	// FreeTop finds the footer at the lowest used address
+	if (footer)
+		new (m_buffer.data() + m_buffer.size() - m_top_offset) StackAllocationFooter(total_size);
+
+	return reinterpret_cast<void*>(block);
+}
+
+void StackAllocator::FreeTop()
+{
+	if (m_top_offset >= sizeof(StackAllocationFooter))
+		m_top_offset -= reinterpret_cast<StackAllocationFooter*>(m_buffer.data() + m_buffer.size() - m_top_offset)->m_alloc_size;
+}
+
 void StackAllocator::Clear()
 {
 	m_offset = 0;
+	m_top_offset = 0;
+}
+
+void StackAllocator::FreeToMarker(const Marker& marker)
+{
+	if (marker > m_offset)
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void FreeToMarker(const Marker&)]: Marker is past the current offset.");
+		return;
+	}
+
+	m_offset = marker;
+}
+
+void StackAllocator::FreeToTopMarker(const Marker& marker)
+{
+	if (marker > m_top_offset)
+	{
+		debug_print("ERROR [StackAllocator.cpp, StackAllocator, void FreeToTopMarker(const Marker&)]: Marker is past the current top offset.");
+		return;
+	}
+
+	m_top_offset = marker;
 }
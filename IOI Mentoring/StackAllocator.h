@@ -8,9 +8,15 @@
 #include "pch.h"
 #include "IAllocator.h"
 
+// Stack that can be used from both ends of the same buffer. The bottom grows up from the start of the buffer and the top grows down
+// from its end, each with its own Free and markers, so two kinds of allocations with different lifetimes (long lived at the bottom,
+// short lived at the top) share the buffer and only their combined peak has to fit.
 class StackAllocator : public IAllocator
 {
 public:
+	// Bytes used at one end at some point, rewinding to it pops everything pushed at that end since
+	using Marker = size_t;
+
 	struct StackAllocationFooter
 	{
 		StackAllocationFooter(const size_t& alloc_size) : m_alloc_size(alloc_size)
@@ -21,25 +27,77 @@ public:
 
 	void Init(std::span<std::byte>&& memory_buffer);
 
+	// alignment has to be 0 (none) or a power of two
 	void* Allocate(size_t size_in_bytes, const size_t& alignment = 0u);
 
+	template <size_t ALIGNMENT>
+	void* Allocate(const size_t& size_in_bytes)
+	{
+		return AllocateWithPadding(size_in_bytes, CalculatePadding<ALIGNMENT>(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset), true);
+	}
+
+	// No footer, so it can only be freed by FreeToMarker or Clear. Free after it would read a footer that isnt there.
+	void* AllocateWithoutFooter(size_t size_in_bytes, const size_t& alignment = 0u);
+
+	template <size_t ALIGNMENT>
+	void* AllocateWithoutFooter(const size_t& size_in_bytes)
+	{
+		return AllocateWithPadding(size_in_bytes, CalculatePadding<ALIGNMENT>(reinterpret_cast<uintptr_t>(m_buffer.data()) + m_offset), false);
+	}
+
 	void Free();
 
+	// Same as Allocate, from the top end
+	void* AllocateTop(size_t size_in_bytes, const size_t& alignment = 0u);
+
+	void* AllocateTopWithoutFooter(size_t size_in_bytes, const size_t& alignment = 0u);
+
+	void FreeTop();
+
+	// Both ends
 	void Clear();
 
+	Marker GetMarker() const
+	{
+		return m_offset;
+	}
+
+	// O(1) whatever the amount of allocations, footers arent read
+	void FreeToMarker(const Marker& marker);
+
+	Marker GetTopMarker() const
+	{
+		return m_top_offset;
+	}
+
+	void FreeToTopMarker(const Marker& marker);
+
 	size_t GetOffset() const
 	{
 		return m_offset;
 	}
 
+	// Bytes used at the top end
+	size_t GetTopOffset() const
+	{
+		return m_top_offset;
+	}
+
 	size_t GetBufferSize() const
 	{
 		return m_buffer.size();
 	}
 
 private:
+	// The padding goes before the allocation and the footer after it, the footer size includes both
+	void* AllocateWithPadding(const size_t& size_in_bytes, const size_t& padding, const bool& footer);
+
+	// The top end grows down, the block is aligned down and the footer goes below it
+	void* AllocateTopWithAlignment(const size_t& size_in_bytes, const size_t& alignment, const bool& footer);
+
 	std::span<std::byte> m_buffer{};
 	size_t m_offset = 0;
+	size_t m_top_offset = 0;
 };
 
 
@@ -0,0 +1,222 @@
+/***************************************************************************//**
+ * @filename ThreadCachedPoolAllocator.cpp
+ * @brief	 Contains the thread cached pool allocator class function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "ThreadCachedPoolAllocator.h"
+
+static std::atomic<unsigned> s_next_allocator_id{ 1u };
+
+// Initialized allocators by id, so an exiting thread only flushes into allocators that still exist
+static std::mutex s_live_allocators_mutex;
+static std::unordered_map<unsigned, ThreadCachedPoolAllocator*> s_live_allocators;
+
+// Cache of the calling thread in the last allocator it used, saves looking through the caches on every call
+static thread_local unsigned t_allocator_id = 0u;
+static thread_local unsigned t_thread_cache = 0u;
+
+// Destroyed when its thread exits, flushes the magazines the thread claimed
+struct ThreadExitFlush
+{
+	~ThreadExitFlush()
+	{
+		std::lock_guard<std::mutex> lock(s_live_allocators_mutex);
+		for (const unsigned& allocator_id : m_allocator_ids)
+		{
+			auto it = s_live_allocators.find(allocator_id);
+			if (it != s_live_allocators.end())
+				it->second->FlushThreadCache();
+		}
+	}
+
+	std::vector<unsigned> m_allocator_ids;
+};
+
+static thread_local ThreadExitFlush t_exit_flush;
+
+ThreadCachedPoolAllocator::~ThreadCachedPoolAllocator()
+{
+	std::lock_guard<std::mutex> lock(s_live_allocators_mutex);
+	s_live_allocators.erase(m_id);
+}
+
+void ThreadCachedPoolAllocator::Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes, const unsigned& magazine_size)
+{
+	if (magazine_size == 0u)
+	{
+		debug_print("ERROR [ThreadCachedPoolAllocator.cpp, ThreadCachedPoolAllocator, void Init(std::span<std::byte>&&, const unsigned&, const unsigned&)]: Magazine size cannot be 0.");
+		return;
+	}
+
+	m_pool.Init(std::forward<std::span<std::byte>>(memory_buffer), chunk_size_in_bytes);
+	m_allocated_bitmap = std::make_unique<std::atomic<uint64_t>[]>((m_pool.GetChunkCount() + 63u) / 64u);
+	m_magazine_size = magazine_size;
+	m_magazine_batch = std::max(1u, magazine_size / 2u);
+
+	m_thread_caches = std::make_unique<ThreadCache[]>(MAX_THREAD_CACHES);
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES; i++)
+		m_thread_caches[i].m_magazine = std::make_unique<void*[]>(m_magazine_size);
+
+	// A new id, so threads that had a cache in the previous Init forget about it
+	std::lock_guard<std::mutex> lock(s_live_allocators_mutex);
+	s_live_allocators.erase(m_id);
+	m_id = s_next_allocator_id++;
+	s_live_allocators[m_id] = this;
+}
+
+ThreadCachedPoolAllocator::ThreadCache* ThreadCachedPoolAllocator::GetThreadCache(const bool& claim)
+{
+	if (t_allocator_id == m_id)
+		return &m_thread_caches[t_thread_cache];
+
+	// Look for the cache this thread already has, otherwise claim a free one
+	const std::thread::id this_thread = std::this_thread::get_id();
+	unsigned cache_index = MAX_THREAD_CACHES;
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES && cache_index == MAX_THREAD_CACHES; i++)
+		if (m_thread_caches[i].m_owner.load(std::memory_order_acquire) == this_thread)
+			cache_index = i;
+
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES && cache_index == MAX_THREAD_CACHES && claim; i++)
+	{
+		std::thread::id no_owner{};
+		if (m_thread_caches[i].m_owner.compare_exchange_strong(no_owner, this_thread, std::memory_order_acquire))
+		{
+			cache_index = i;
+
+			// Flush it when the thread exits
+			if (std::find(t_exit_flush.m_allocator_ids.begin(), t_exit_flush.m_allocator_ids.end(), m_id) == t_exit_flush.m_allocator_ids.end())
+				t_exit_flush.m_allocator_ids.push_back(m_id);
+		}
+	}
+
+	if (cache_index == MAX_THREAD_CACHES)
+		return nullptr;
+
+	t_allocator_id = m_id;
+	t_thread_cache = cache_index;
+	return &m_thread_caches[cache_index];
+}
+
+void ThreadCachedPoolAllocator::FlushMagazine(ThreadCache& cache, const unsigned& count)
+{
+	// The bottom of the magazine has the chunks freed longest ago, the ones on top are more likely to still be in cache
+	m_pool.FreeN(std::span<void* const>(cache.m_magazine.get(), count));
+
+	std::copy(cache.m_magazine.get() + count, cache.m_magazine.get() + cache.m_count, cache.m_magazine.get());
+	cache.m_count -= count;
+}
+
+void ThreadCachedPoolAllocator::MarkChunkAllocated(void* chunk)
+{
+	if (chunk == nullptr)
+		return;
+
+	const unsigned chunk_index = m_pool.GetChunkIndex(chunk);
+	m_allocated_bitmap[chunk_index / 64u].fetch_or(uint64_t(1u) << (chunk_index % 64u), std::memory_order_relaxed);
+}
+
+bool ThreadCachedPoolAllocator::MarkChunkFreed(void* chunk)
+{
+	const unsigned chunk_index = m_pool.GetChunkIndex(chunk);
+	const uint64_t bit = uint64_t(1u) << (chunk_index % 64u);
+	return m_allocated_bitmap[chunk_index / 64u].fetch_and(~bit, std::memory_order_relaxed) & bit;
+}
+
+void* ThreadCachedPoolAllocator::Allocate()
+{
+	void* chunk = nullptr;
+
+	ThreadCache* cache = GetThreadCache();
+	if (cache == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(m_pool_mutex);
+		chunk = m_pool.Allocate();
+	}
+	else
+	{
+		if (cache->m_count == 0u)
+		{
+			std::lock_guard<std::mutex> lock(m_pool_mutex);
+
+			// Dont ask for more than there is, the pool reports every failed allocation. It returns nullptr, there is nothing to mark.
+			const unsigned refill_count = std::min(m_magazine_batch, m_pool.GetFreeChunkAmount());
+			if (refill_count == 0u)
+				return m_pool.Allocate();
+
+			// Reversed so the magazine hands them out in the order the pool did
+			cache->m_count = m_pool.AllocateN(std::span<void*>(cache->m_magazine.get(), refill_count));
+			std::reverse(cache->m_magazine.get(), cache->m_magazine.get() + cache->m_count);
+		}
+
+		chunk = cache->m_magazine[--cache->m_count];
+	}
+
+	MarkChunkAllocated(chunk);
+	return chunk;
+}
+
+void ThreadCachedPoolAllocator::Free(void* ptr)
+{
+	// Only reads what Init set, so it is safe without the lock
+	if (!m_pool.IsChunkPtrValid(ptr))
+		return;
+
+	// Cleared before the chunk goes anywhere, so only one of two frees of the same chunk gets past this
+	if (!MarkChunkFreed(ptr))
+	{
+		debug_print("ERROR [ThreadCachedPoolAllocator.cpp, ThreadCachedPoolAllocator, void Free(void*)]: Ptr to deallocate was not allocated.");
+		return;
+	}
+
+	ThreadCache* cache = GetThreadCache();
+	if (cache == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(m_pool_mutex);
+		m_pool.Free(ptr);
+		return;
+	}
+
+	if (cache->m_count == m_magazine_size)
+	{
+		std::lock_guard<std::mutex> lock(m_pool_mutex);
+		FlushMagazine(*cache, m_magazine_batch);
+	}
+
+	cache->m_magazine[cache->m_count++] = ptr;
+}
+
+void ThreadCachedPoolAllocator::FlushThreadCache()
+{
+	ThreadCache* cache = GetThreadCache(false);
+	if (cache == nullptr)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_pool_mutex);
+		FlushMagazine(*cache, cache->m_count);
+	}
+
+	cache->m_owner.store(std::thread::id{}, std::memory_order_release);
+	t_allocator_id = 0u;
+}
+
+void ThreadCachedPoolAllocator::Clear()
+{
+	m_pool.Clear();
+
+	for (unsigned i = 0u; i < (m_pool.GetChunkCount() + 63u) / 64u; i++)
+		m_allocated_bitmap[i].store(0u, std::memory_order_relaxed);
+
+	// The threads keep their caches, only what was in them is gone
+	for (unsigned i = 0u; i < MAX_THREAD_CACHES; i++)
+		m_thread_caches[i].m_count = 0u;
+}
+
+unsigned ThreadCachedPoolAllocator::GetFreeChunkAmount() const
+{
+	std::lock_guard<std::mutex> lock(m_pool_mutex);
+	return m_pool.GetFreeChunkAmount();
+}
@@ -0,0 +1,95 @@
+/***************************************************************************//**
+ * @filename ThreadCachedPoolAllocator.h
+ * @brief	 Contains the thread cached pool allocator class header.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#pragma once
+#include "pch.h"
+#include "IAllocator.h"
+#include "PoolAllocator.h"
+
+// A pool allocator shared by every thread behind a lock, with a magazine (a bounded stack of chunk ptrs) per thread in front of it.
+// Allocate pops from the calling thread's magazine and Free pushes to it, the shared pool is only locked to refill an empty magazine
+// or flush a full one, half a magazine at a time. Magazines are flushed automatically when their thread exits.
+class ThreadCachedPoolAllocator : public IAllocator
+{
+public:
+	static constexpr unsigned DEFAULT_MAGAZINE_SIZE = 64u;
+	static constexpr unsigned MAX_THREAD_CACHES = 64u;				// Threads after this one lock the pool on every call
+
+	ThreadCachedPoolAllocator() = default;
+	~ThreadCachedPoolAllocator();
+
+	ThreadCachedPoolAllocator(const ThreadCachedPoolAllocator&) = delete;
+	ThreadCachedPoolAllocator& operator=(const ThreadCachedPoolAllocator&) = delete;
+
+	// Not thread safe, nothing can be using the allocator while it is initialized
+	void Init(std::span<std::byte>&& memory_buffer, const unsigned& chunk_size_in_bytes, const unsigned& magazine_size = DEFAULT_MAGAZINE_SIZE);
+
+	void* Allocate();
+
+	// The chunks in the magazines are still allocated as far as the pool knows, so the allocator tracks which chunks the callers have.
+	// Double frees and frees of chunks that were already given back to the pool are caught from any thread without locking it.
+	void Free(void* ptr);
+
+	// Gives the calling thread's magazine back to the pool and releases it for other threads. Threads that exit do it on their own,
+	// call it to give the chunks back earlier.
+	void FlushThreadCache();
+
+	// Not thread safe, nothing can be using the allocator while it is cleared
+	void Clear();
+
+	size_t GetBufferSize() const
+	{
+		return m_pool.GetBufferSize();
+	}
+
+	size_t GetChunkSize() const
+	{
+		return m_pool.GetChunkSize();
+	}
+
+	unsigned GetMagazineSize() const
+	{
+		return m_magazine_size;
+	}
+
+	// Chunks in the magazines count as allocated
+	unsigned GetFreeChunkAmount() const;
+
+private:
+	// Only touched by the thread that owns it, m_owner is the only member other threads read
+	struct alignas(64) ThreadCache
+	{
+		std::atomic<std::thread::id> m_owner{};
+
+		unsigned m_count = 0u;
+		std::unique_ptr<void*[]> m_magazine;
+	};
+
+	// claim is false when the thread is only looking for the cache it already has
+	ThreadCache* GetThreadCache(const bool& claim = true);
+
+	// Has to be called with the pool locked, gives back count chunks from the bottom of the magazine and moves the rest down
+	void FlushMagazine(ThreadCache& cache, const unsigned& count);
+
+	// Sets the chunk's bit in the allocated bitmap, chunk can be nullptr
+	void MarkChunkAllocated(void* chunk);
+
+	// Clears the chunk's bit in the allocated bitmap, returns false if it was already clear
+	bool MarkChunkFreed(void* chunk);
+
+	mutable std::mutex m_pool_mutex;
+	PoolAllocator m_pool;
+
+	// One bit per chunk, set while a caller has it and clear while it is in the pool or a magazine. Atomic as every thread sets and
+	// clears bits, relaxed as only the bit itself matters.
+	std::unique_ptr<std::atomic<uint64_t>[]> m_allocated_bitmap;
+
+	std::unique_ptr<ThreadCache[]> m_thread_caches;
+	unsigned m_magazine_size = 0u;
+	unsigned m_magazine_batch = 0u;		// Chunks moved between a magazine and the pool at once
+
+	unsigned m_id = 0u;			// Unique per Init, lets threads remember which cache is theirs
+};
@@ -0,0 +1,124 @@
+/***************************************************************************//**
+ * @filename UT_ChainedLinearAllocator.cpp
+ * @brief	 Contains the chained linear allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "ChainedLinearAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool chainedlinear_init()
+		{
+			ChainedLinearAllocator cla;
+			cla.Init(64);
+
+			// No block until the first allocation
+			return cla.GetBlockCount() == 0 && cla.GetCapacity() == 0 && cla.GetOffset() == 0;
+		}
+
+		bool chainedlinear_allocate_0()
+		{
+			ChainedLinearAllocator cla;
+			cla.Init(64);
+
+			std::byte* data_0 = static_cast<std::byte*>(cla.Allocate(3));
+			std::byte* data_1 = static_cast<std::byte*>(cla.Allocate(8, 8));
+			std::byte* data_2 = static_cast<std::byte*>(cla.Allocate(4, 16));
+
+			return cla.GetBlockCount() == 1 && cla.GetCurrentBlockSize() == 64 && data_1 == data_0 + 8 && reinterpret_cast<uintptr_t>(data_1) % 8 == 0 &&
+				   reinterpret_cast<uintptr_t>(data_2) % 16 == 0 && cla.GetOffset() == static_cast<size_t>(data_2 - data_0) + 4 &&
+				   cla.Allocate(0) == nullptr && cla.Allocate(8, 3) == nullptr && cla.GetOffset() == static_cast<size_t>(data_2 - data_0) + 4;
+		}
+
+		bool chainedlinear_allocate_1()
+		{
+			ChainedLinearAllocator cla;
+			cla.Init(64);
+
+			// Blocks double in size
+			cla.Allocate(48);
+			cla.Allocate(48);
+			const bool doubled = cla.GetBlockCount() == 2 && cla.GetCurrentBlockSize() == 128 && cla.GetOffset() == 48;
+			cla.Allocate(96);
+			const bool doubled_again = cla.GetBlockCount() == 3 && cla.GetCurrentBlockSize() == 256;
+
+			// Allocations larger than the next block get a block of their own size
+			void* data = cla.Allocate(1000, 64);
+
+			return doubled && doubled_again && data != nullptr && reinterpret_cast<uintptr_t>(data) % 64 == 0 && cla.GetBlockCount() == 4 &&
+				   cla.GetCurrentBlockSize() >= 1000 && cla.GetCapacity() == 64 + 128 + 256 + cla.GetCurrentBlockSize();
+		}
+
+		bool chainedlinear_allocate_2()
+		{
+			std::vector<std::byte> buffer(768);
+			FreeListAllocator fla;
+			fla.Init(buffer);
+			FreeListSlabSource upstream(fla);
+
+			// The upstream allocator fits the 128 and 256 byte blocks but not the 512 one
+			ChainedLinearAllocator cla;
+			cla.Init(128, upstream);
+
+			cla.Allocate(128);
+			cla.Allocate(256);
+			void* data = cla.Allocate(512);
+
+			return data == nullptr && cla.GetBlockCount() == 2 && cla.Allocate(1) == nullptr;
+		}
+
+		bool chainedlinear_clear()
+		{
+			std::vector<std::byte> buffer(4096);
+			FreeListAllocator fla;
+			fla.Init(buffer);
+			FreeListSlabSource upstream(fla);
+
+			ChainedLinearAllocator cla;
+			cla.Init(64, upstream);
+
+			cla.Allocate(64);
+			cla.Allocate(128);
+			cla.Allocate(256);
+			cla.Clear();
+
+			// Only the largest block is kept, new blocks keep growing from it
+			const bool kept = cla.GetBlockCount() == 1 && cla.GetCurrentBlockSize() == 256 && cla.GetOffset() == 0 && fla.GetStats().m_alloc_chunk_count == 1;
+
+			cla.Allocate(256);
+			cla.Allocate(1);
+
+			return kept && cla.GetBlockCount() == 2 && cla.GetCurrentBlockSize() == 512 && fla.GetStats().m_alloc_chunk_count == 2;
+		}
+
+		bool chainedlinear_prod()
+		{
+			ChainedLinearAllocator cla;
+			cla.Init(sizeof(AllocatorTestClass) * 2);
+
+			// Request sizes that vary a lot, the arena grows to fit them and keeps one block between requests
+			bool valid = true;
+			for (unsigned request = 1u; request <= 64u; request *= 4u)
+			{
+				std::vector<AllocatorTestClass*> objects;
+				for (unsigned i = 0u; i < request; i++)
+					objects.push_back(new (cla.Allocate(sizeof(AllocatorTestClass), alignof(AllocatorTestClass))) AllocatorTestClass(1.5, i));
+
+				for (unsigned i = 0u; i < request; i++)
+					valid = valid && *objects[i] == AllocatorTestClass(1.5, i);
+
+				cla.Clear();
+				valid = valid && cla.GetBlockCount() == 1;
+			}
+
+			return valid && cla.GetCurrentBlockSize() >= sizeof(AllocatorTestClass) * 64;
+		}
+	}
+}
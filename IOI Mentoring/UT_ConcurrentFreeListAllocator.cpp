@@ -0,0 +1,270 @@
+/***************************************************************************//**
+ * @filename UT_ConcurrentFreeListAllocator.cpp
+ * @brief	 Contains the thread safe free list allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "ConcurrentFreeListAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool concurrentfreelist_init()
+		{
+			ConcurrentFreeListAllocator cfla;
+			alignas(64) std::byte buffer[4096];
+			cfla.Init(buffer, 4);
+
+			const FreeListAllocatorBase::FreeListStats stats = cfla.GetStats();
+
+			// Each arena loses the bytes in front of its first aligned header and the rest of the last granule
+			return cfla.GetBufferSize() == 4096 && cfla.GetArenaCount() == 4 && stats.m_free_chunk_count == 4 &&
+				   stats.m_bytes_free == 4 * (1024 - ConcurrentFreeListAllocator::MIN_ALIGNMENT - FreeListAllocatorBase::SIZE_ALLOC_HEADER);
+		}
+
+		bool concurrentfreelist_allocate_0()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::byte buffer[4096];
+			cfla.Init(buffer, 2);
+
+			// Small chunks are taken from the arena in batches
+			void* chunk_0 = cfla.Allocate(20);
+			bool batch_taken = cfla.GetStats().m_alloc_chunk_count == ConcurrentFreeListAllocator::CACHE_BATCH;
+
+			// Large chunks are not
+			void* chunk_1 = cfla.Allocate(ConcurrentFreeListAllocator::MAX_SMALL_SIZE + 1);
+			bool large_taken = cfla.GetStats().m_alloc_chunk_count == ConcurrentFreeListAllocator::CACHE_BATCH + 1;
+
+			// Too large for any arena
+			void* chunk_2 = cfla.Allocate(4096);
+
+			cfla.FlushThreadCache();
+
+			return chunk_0 != nullptr && batch_taken && chunk_1 != nullptr && large_taken && chunk_2 == nullptr;
+		}
+
+		bool concurrentfreelist_allocate_1()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::byte buffer[4096];
+			cfla.Init(buffer, 2);
+
+			void* chunk_0 = cfla.Allocate(24, 64);
+
+			cfla.Free(chunk_0);
+			cfla.FlushThreadCache();
+
+			return chunk_0 != nullptr && reinterpret_cast<uintptr_t>(chunk_0) % 64 == 0 && cfla.GetStats().m_alloc_chunk_count == 0;
+		}
+
+		bool concurrentfreelist_free_0()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::byte buffer[4096];
+			cfla.Init(buffer, 2);
+
+			std::vector<void*> chunks;
+			for (int i = 0; i < 40; i++)
+				chunks.push_back(cfla.Allocate(16 + i));
+
+			for (void* chunk : chunks)
+				cfla.Free(chunk);
+
+			int* temp_ptr = new int;
+			cfla.Free(static_cast<void*>(temp_ptr));
+			delete temp_ptr;
+
+			// Flushing gives back the cached chunks and the pending frees
+			cfla.FlushThreadCache();
+
+			const FreeListAllocatorBase::FreeListStats stats = cfla.GetStats();
+
+			return stats.m_alloc_chunk_count == 0 && stats.m_free_chunk_count == 2;
+		}
+
+		bool concurrentfreelist_free_1()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::byte buffer[8192];
+			cfla.Init(buffer, 4);
+
+			// Allocated in another thread, freed in this one
+			std::vector<void*> chunks;
+			std::thread allocating_thread([&cfla, &chunks]()
+				{
+					for (int i = 0; i < 32; i++)
+						chunks.push_back(cfla.Allocate(i % 2 == 0 ? 32 : 300));
+
+					cfla.FlushThreadCache();
+				});
+			allocating_thread.join();
+
+			for (void* chunk : chunks)
+				cfla.Free(chunk);
+
+			cfla.FlushThreadCache();
+
+			const FreeListAllocatorBase::FreeListStats stats = cfla.GetStats();
+
+			return std::find(chunks.begin(), chunks.end(), nullptr) == chunks.end() && stats.m_alloc_chunk_count == 0 && stats.m_free_chunk_count == 4;
+		}
+
+		bool concurrentfreelist_free_2()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::vector<std::byte> buffer(16384);
+			cfla.Init(buffer, 4);
+
+			// More threads than caches, none of them flushes. Their caches are flushed and released when they exit.
+			bool allocated = true;
+			for (unsigned i = 0u; i < ConcurrentFreeListAllocator::MAX_THREAD_CACHES * 2u; i++)
+			{
+				std::thread thread([&cfla, &allocated]()
+					{
+						std::array<void*, 4> chunks{};
+						for (void*& chunk : chunks)
+							chunk = cfla.Allocate(32);
+
+						allocated = allocated && std::find(chunks.begin(), chunks.end(), nullptr) == chunks.end();
+
+						for (void* chunk : chunks)
+							cfla.Free(chunk);
+					});
+				thread.join();
+			}
+
+			const FreeListAllocatorBase::FreeListStats stats = cfla.GetStats();
+
+			return allocated && stats.m_alloc_chunk_count == 0;
+		}
+
+		bool concurrentfreelist_free_3()
+		{
+			ConcurrentFreeListAllocator cfla;
+			alignas(64) std::byte buffer[4096];
+			cfla.Init(buffer, 2);
+
+			// The chunks go through the bins, a chunk that got in twice would be handed out twice
+			std::vector<void*> chunks;
+			auto allocate_distinct = [&cfla, &chunks](const unsigned& count, void* freed_chunk)
+				{
+					for (unsigned i = 0u; i < count; i++)
+						chunks.push_back(cfla.Allocate(32));
+
+					std::vector<void*> sorted_chunks = chunks;
+					std::sort(sorted_chunks.begin(), sorted_chunks.end());
+					return std::adjacent_find(sorted_chunks.begin(), sorted_chunks.end()) == sorted_chunks.end() &&
+						   std::count(chunks.begin(), chunks.end(), freed_chunk) == 1;
+				};
+
+			// Freed twice before the pending frees are flushed
+			void* chunk_0 = cfla.Allocate(32);
+			cfla.Free(chunk_0);
+			cfla.Free(chunk_0);
+			const bool pending_freed_once = allocate_distinct(ConcurrentFreeListAllocator::CACHE_BATCH * 2u, chunk_0);
+
+			// Freed again while it sits in a bin, from this thread and from one with another home arena
+			void* chunk_1 = chunks.front();
+			chunks.erase(chunks.begin());
+			cfla.Free(chunk_1);
+			chunks.push_back(cfla.Allocate(32));
+
+			cfla.Free(chunk_1);
+			std::thread freeing_thread([&cfla, chunk_1]()
+				{
+					cfla.Free(chunk_1);
+					cfla.FlushThreadCache();
+				});
+			freeing_thread.join();
+
+			const bool cached_freed_once = allocate_distinct(ConcurrentFreeListAllocator::CACHE_BATCH, chunk_1);
+
+			for (void* chunk : chunks)
+				cfla.Free(chunk);
+
+			cfla.FlushThreadCache();
+
+			return pending_freed_once && cached_freed_once && cfla.GetStats().m_alloc_chunk_count == 0;
+		}
+
+		bool concurrentfreelist_clear()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::byte buffer[4096];
+			cfla.Init(buffer, 2);
+
+			cfla.Allocate(16);
+			cfla.Allocate(1024);
+
+			cfla.Clear();
+
+			const FreeListAllocatorBase::FreeListStats stats = cfla.GetStats();
+			bool cleared = stats.m_alloc_chunk_count == 0 && stats.m_free_chunk_count == 2;
+
+			// The cache is empty after clearing, so it takes a new batch
+			void* chunk_0 = cfla.Allocate(16);
+			bool batch_taken = cfla.GetStats().m_alloc_chunk_count == ConcurrentFreeListAllocator::CACHE_BATCH;
+
+			cfla.Free(chunk_0);
+			cfla.FlushThreadCache();
+
+			return cleared && batch_taken && cfla.GetStats().m_alloc_chunk_count == 0;
+		}
+
+		bool concurrentfreelist_prod()
+		{
+			ConcurrentFreeListAllocator cfla;
+			std::vector<std::byte> buffer(1u << 22);
+			cfla.Init(buffer, 4);
+
+			std::atomic<bool> data_kept = true;
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 8; t++)
+			{
+				threads.emplace_back([&cfla, &data_kept, t]()
+					{
+						std::vector<AllocatorTestClass*> chunks;
+						for (int i = 0; i < 4000; i++)
+						{
+							// Mostly small chunks with the odd large one
+							const unsigned count = i % 16 == 0 ? 40u : 1u + i % 8;
+							void* chunk = cfla.Allocate(sizeof(AllocatorTestClass) * count);
+							data_kept = data_kept && reinterpret_cast<uintptr_t>(chunk) % ConcurrentFreeListAllocator::MIN_ALIGNMENT == 0;
+							chunks.push_back(new (chunk) AllocatorTestClass(i * 0.5, t));
+
+							if (i % 3 == 2)
+							{
+								for (int j = 0; j < 2; j++)
+								{
+									data_kept = data_kept && chunks.back()->x == t;
+									cfla.Free(chunks.back());
+									chunks.pop_back();
+								}
+							}
+						}
+
+						for (AllocatorTestClass* chunk : chunks)
+						{
+							data_kept = data_kept && chunk->x == t;
+							cfla.Free(chunk);
+						}
+
+						cfla.FlushThreadCache();
+					});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			const FreeListAllocatorBase::FreeListStats stats = cfla.GetStats();
+
+			return data_kept && stats.m_alloc_chunk_count == 0 && stats.m_free_chunk_count == cfla.GetArenaCount();
+		}
+	}
+}
@@ -0,0 +1,186 @@
+/***************************************************************************//**
+ * @filename UT_ConcurrentPoolAllocator.cpp
+ * @brief	 Contains the lock free pool allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "ConcurrentPoolAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool concurrentpool_init()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::byte buffer[96];
+			cpa.Init(buffer, 8);
+
+			return cpa.GetBufferSize() == 96 && cpa.GetChunkSize() == 8 && cpa.GetFreeChunkAmount() == 12;
+		}
+
+		bool concurrentpool_allocate_0()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::byte buffer[96];
+			cpa.Init(buffer, 4);
+
+			std::vector<void*> chunks;
+			for (unsigned i = 0u; i < 24; i++)
+				chunks.push_back(cpa.Allocate());
+
+			void* chunk_24 = cpa.Allocate();
+
+			return cpa.GetFreeChunkAmount() == 0 && chunk_24 == nullptr && chunks.front() == buffer && chunks.back() == buffer + 92 &&
+				   !cpa.IsChunkFree(chunks[10]);
+		}
+
+		bool concurrentpool_free_0()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::byte buffer[96];
+			cpa.Init(buffer, 8);
+
+			void* chunk_0 = cpa.Allocate();
+			void* chunk_1 = cpa.Allocate();
+			cpa.Free(chunk_0);
+
+			// Invalid ptrs and double frees are ignored
+			int* temp_ptr = new int;
+			cpa.Free(static_cast<void*>(temp_ptr));
+			delete temp_ptr;
+			cpa.Free(static_cast<std::byte*>(chunk_1) + 2);
+			cpa.Free(chunk_0);
+
+			// The last freed chunk is the first one to be allocated again
+			bool chunk_reused = cpa.GetFreeChunkAmount() == 11 && cpa.IsChunkFree(chunk_0) && cpa.Allocate() == chunk_0;
+
+			return chunk_reused && cpa.GetFreeChunkAmount() == 10 && !cpa.IsChunkFree(chunk_1);
+		}
+
+		bool concurrentpool_batch()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::byte buffer[256];
+			cpa.Init(buffer, 8);
+
+			std::array<void*, 20> chunks{};
+			unsigned count = cpa.AllocateN(chunks);
+			bool allocated = count == 20 && chunks[0] == buffer && chunks[19] == buffer + 19 * 8 && cpa.GetFreeChunkAmount() == 12 &&
+							 !cpa.IsChunkFree(chunks[10]);
+
+			// Invalid ptrs and double frees are skipped
+			std::array<void*, 4> to_free = { chunks[4], chunks[9], chunks[4], buffer + 3 };
+			cpa.FreeN(to_free);
+			bool freed = cpa.GetFreeChunkAmount() == 14 && cpa.IsChunkFree(chunks[4]) && cpa.IsChunkFree(chunks[9]);
+
+			// Only what is left is handed out, the last freed chunk first
+			std::array<void*, 32> rest{};
+			unsigned rest_count = cpa.AllocateN(rest);
+
+			return allocated && freed && rest_count == 14 && rest[0] == chunks[9] && rest[1] == chunks[4] && cpa.GetFreeChunkAmount() == 0;
+		}
+
+		bool concurrentpool_clear()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::byte buffer[96];
+			cpa.Init(buffer, 8);
+
+			cpa.Allocate();
+			void* chunk_1 = cpa.Allocate();
+			cpa.Clear();
+
+			return cpa.GetFreeChunkAmount() == 12 && cpa.IsChunkFree(chunk_1) && cpa.Allocate() == buffer;
+		}
+
+		bool concurrentpool_prod()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::vector<std::byte> buffer(sizeof(AllocatorTestClass) * 256);
+			cpa.Init(buffer, sizeof(AllocatorTestClass));
+
+			// Every thread can hold up to 32 chunks so the pool is just big enough, chunks keep moving between threads
+			std::atomic<bool> data_kept = true;
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 8; t++)
+			{
+				threads.emplace_back([&cpa, &data_kept, t]()
+					{
+						std::vector<AllocatorTestClass*> chunks;
+						for (int i = 0; i < 20000; i++)
+						{
+							if (chunks.size() < 32 && i % 4 != 3)
+							{
+								if (void* chunk = cpa.Allocate())
+									chunks.push_back(new (chunk) AllocatorTestClass(i * 0.5, t));
+							}
+							else if (!chunks.empty())
+							{
+								data_kept = data_kept && chunks.back()->x == t;
+								cpa.Free(chunks.back());
+								chunks.pop_back();
+							}
+						}
+
+						for (AllocatorTestClass* chunk : chunks)
+						{
+							data_kept = data_kept && chunk->x == t;
+							cpa.Free(chunk);
+						}
+					});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			return data_kept && cpa.GetFreeChunkAmount() == 256;
+		}
+
+		bool concurrentpool_prod_batch()
+		{
+			ConcurrentPoolAllocator cpa;
+			std::vector<std::byte> buffer(sizeof(AllocatorTestClass) * 256);
+			cpa.Init(buffer, sizeof(AllocatorTestClass));
+
+			// Every thread takes and gives back batches of up to 32 chunks, next to threads allocating one at a time
+			std::atomic<bool> data_kept = true;
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 8; t++)
+			{
+				threads.emplace_back([&cpa, &data_kept, t]()
+					{
+						std::array<void*, 32> chunks{};
+						for (int i = 0; i < 4000; i++)
+						{
+							unsigned count = 0u;
+							if (t % 2 == 0)
+								count = cpa.AllocateN(std::span<void*>(chunks.data(), 1u + i % 32));
+							else if ((chunks[0] = cpa.Allocate()) != nullptr)
+								count = 1u;
+
+							for (unsigned j = 0u; j < count; j++)
+								new (chunks[j]) AllocatorTestClass(i * 0.5, t);
+
+							for (unsigned j = 0u; j < count; j++)
+								data_kept = data_kept && static_cast<AllocatorTestClass*>(chunks[j])->x == t;
+
+							if (t % 2 == 0)
+								cpa.FreeN(std::span<void* const>(chunks.data(), count));
+							else if (count != 0u)
+								cpa.Free(chunks[0]);
+						}
+					});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			return data_kept && cpa.GetFreeChunkAmount() == 256;
+		}
+	}
+}
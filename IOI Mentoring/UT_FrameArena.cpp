@@ -0,0 +1,174 @@
+/***************************************************************************//**
+ * @filename UT_FrameArena.cpp
+ * @brief	 Contains the frame arena unit test function implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "FrameArena.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool framearena_init()
+		{
+			FrameArena fa;
+			std::byte buffer[48];
+			fa.Init(buffer);
+
+			return fa.GetBufferSize() == 48 && fa.GetOffset() == 0 && fa.GetLiveAllocationCount() == 0;
+		}
+
+		bool framearena_free_0()
+		{
+			FrameArena fa;
+			std::byte buffer[48];
+			fa.Init(buffer);
+
+			void* data_0 = fa.Allocate(8);
+			void* data_1 = fa.Allocate(16);
+
+			// Nothing is given back until the last allocation is freed
+			fa.Free(data_0);
+			const bool kept = fa.GetOffset() == 24 && fa.GetLiveAllocationCount() == 1;
+
+			fa.Free(data_1);
+
+			return kept && fa.GetOffset() == 0 && fa.GetLiveAllocationCount() == 0 && fa.Allocate(48) == buffer;
+		}
+
+		bool framearena_free_1()
+		{
+			FrameArena fa;
+			std::byte buffer[48];
+			fa.Init(buffer);
+
+			void* data_0 = fa.Allocate(8);
+
+			// Out of the buffer and not allocated yet
+			int number = 0;
+			fa.Free(&number);
+			fa.Free(&buffer[16]);
+			const bool kept = fa.GetOffset() == 8 && fa.GetLiveAllocationCount() == 1;
+
+			// More frees than allocations, the second one sees an empty arena
+			fa.Free(data_0);
+			fa.Free(data_0);
+
+			return kept && fa.GetOffset() == 0 && fa.GetLiveAllocationCount() == 0;
+		}
+
+		bool framearena_buffered_0()
+		{
+			BufferedFrameArena bfa;
+			std::byte buffer[96];
+			bfa.Init(buffer, 3);
+
+			void* data_0 = bfa.Allocate(16);
+			bfa.NextFrame();
+			void* data_1 = bfa.Allocate(16);
+			bfa.NextFrame();
+			void* data_2 = bfa.Allocate(16);
+
+			// Previous frames are still there until the rotation gets back to them
+			const bool rotated = bfa.GetFrameSize() == 32 && data_0 == &buffer[0] && data_1 == &buffer[32] && data_2 == &buffer[64] &&
+								 bfa.GetFrame(0).GetOffset() == 16 && bfa.GetFrame(1).GetOffset() == 16;
+
+			bfa.NextFrame();
+			void* data_3 = bfa.Allocate(32);
+
+			return rotated && bfa.GetCurrentFrame() == 0 && data_3 == &buffer[0] && bfa.GetFrame(0).GetLiveAllocationCount() == 1 &&
+				   bfa.GetFrame(1).GetOffset() == 16 && bfa.Allocate(1) == nullptr;
+		}
+
+		bool framearena_buffered_1()
+		{
+			BufferedFrameArena bfa;
+			std::byte buffer[64];
+
+			// Invalid frame counts
+			bfa.Init(buffer, 0);
+			bfa.Init(buffer, BufferedFrameArena::MAX_FRAME_COUNT + 1);
+			const bool invalid = bfa.GetFrameCount() == 0 && bfa.Allocate(8) == nullptr;
+
+			bfa.Init(buffer);
+
+			void* data_0 = bfa.Allocate(8);
+			bfa.NextFrame();
+			void* data_1 = bfa.Allocate(8);
+
+			// Frees go to the frame the ptr belongs to
+			bfa.Free(data_0);
+			int number = 0;
+			bfa.Free(&number);
+
+			return invalid && bfa.GetFrameCount() == 2 && bfa.GetFrame(0).GetOffset() == 0 && bfa.GetFrame(1).GetOffset() == 8 && data_1 == &buffer[32];
+		}
+
+		bool framearena_buffered_2()
+		{
+			BufferedFrameArena bfa;
+			std::byte buffer[64];
+			bfa.Init(buffer);
+
+			void* data_0 = bfa.Allocate(8);
+			void* data_1 = bfa.Allocate(8);
+			bfa.NextFrame();
+			bfa.NextFrame();
+
+			// Frame 0 is recycled, the ptrs of its previous use are stale and cant free what the new one allocated
+			void* data_2 = bfa.Allocate(16);
+			void* data_3 = bfa.Allocate(8);
+			bfa.Free(data_1);
+			bfa.Free(data_2);
+			bfa.Free(data_2);
+			const bool stale = data_0 == data_2 && bfa.GetFrame(0).GetLiveAllocationCount() == 1 && bfa.GetFrame(0).GetOffset() == 24;
+
+			bfa.Free(data_3);
+
+			return stale && bfa.GetFrame(0).GetLiveAllocationCount() == 0 && bfa.GetFrame(0).GetOffset() == 0;
+		}
+
+		bool framearena_clear()
+		{
+			BufferedFrameArena bfa;
+			std::byte buffer[64];
+			bfa.Init(buffer, 4);
+
+			bfa.Allocate(8);
+			bfa.NextFrame();
+			bfa.Allocate(8);
+			bfa.Clear();
+
+			return bfa.GetCurrentFrame() == 0 && bfa.GetFrame(0).GetOffset() == 0 && bfa.GetFrame(1).GetOffset() == 0 &&
+				   bfa.GetFrame(1).GetLiveAllocationCount() == 0;
+		}
+
+		bool framearena_prod()
+		{
+			FrameArena fa;
+			std::byte buffer[sizeof(AllocatorTestClass) * 8];
+			fa.Init(buffer);
+
+			// Each request frees what it allocated and the next one starts from the beginning
+			bool reused = true;
+			for (unsigned request = 0u; request < 16u; request++)
+			{
+				AllocatorTestClass* data_0 = new (fa.Allocate(sizeof(AllocatorTestClass))) AllocatorTestClass(1.2, request);
+				AllocatorTestClass* data_1 = new (fa.Allocate(sizeof(AllocatorTestClass))) AllocatorTestClass(1.5, request + 1);
+
+				reused = reused && static_cast<void*>(data_0) == buffer && *data_0 == AllocatorTestClass(1.2, request) && *data_1 == AllocatorTestClass(1.5, request + 1);
+
+				data_1->~AllocatorTestClass();
+				fa.Free(data_1);
+				data_0->~AllocatorTestClass();
+				fa.Free(data_0);
+			}
+
+			return reused && fa.GetOffset() == 0;
+		}
+	}
+}
@@ -132,6 +132,147 @@ namespace UT
 			return free_chunks.size() == 2 && free_chunks.front()->m_chunk_size == 16 && free_chunks.back()->m_chunk_size == 256 - 16 - 12 - 14 - 12 - 5 * sizeof(FreeListAllocator::FreeListAllocHeader);
 		}
 
+		bool freelist_allocate_bestfit_3()
+		{
+			FreeListAllocator flabf(FreeListAllocator::e_AllocType::e_firstfit);
+			std::byte buffer[512];
+			flabf.Init(buffer);
+
+			void* chunk_to_free_0 = flabf.Allocate(40);
+			flabf.Allocate(12);
+			void* chunk_to_free_1 = flabf.Allocate(24);
+			flabf.Allocate(12);
+			void* chunk_to_free_2 = flabf.Allocate(32);
+			flabf.Allocate(12);
+
+			flabf.Free(chunk_to_free_0);
+			flabf.Free(chunk_to_free_1);
+			flabf.Free(chunk_to_free_2);
+
+			// Changing the alloc type at runtime moves the free chunks into the size tree
+			flabf.SetAllocType(FreeListAllocator::e_AllocType::e_bestfit);
+
+			void* chunk_0 = flabf.Allocate(20);
+			void* chunk_1 = flabf.Allocate(36);
+
+			return chunk_0 == chunk_to_free_1 && chunk_1 == chunk_to_free_0 && flabf.GetFreeChunks().size() == 2;
+		}
+
+		bool freelist_allocate_nextfit_0()
+		{
+			FreeListAllocator flanf(FreeListAllocator::e_AllocType::e_nextfit);
+			std::byte buffer[256];
+			flanf.Init(buffer);
+
+			void* chunk_to_free_0 = flanf.Allocate(16);
+			flanf.Allocate(16);
+			void* chunk_to_free_1 = flanf.Allocate(16);
+			flanf.Allocate(16);
+
+			flanf.Free(chunk_to_free_0);
+			flanf.Free(chunk_to_free_1);
+
+			// The search resumes where the last allocation ended (the end of the buffer) instead of going back to the freed chunks
+			void* chunk_0 = flanf.Allocate(16);
+
+			// Once we change to first fit, the search starts from the head of the free list again
+			flanf.SetAllocType(FreeListAllocator::e_AllocType::e_firstfit);
+			void* chunk_1 = flanf.Allocate(16);
+
+			return chunk_0 != chunk_to_free_0 && chunk_0 != chunk_to_free_1 && (chunk_1 == chunk_to_free_0 || chunk_1 == chunk_to_free_1) &&
+				   flanf.GetFreeChunks().size() == 2;
+		}
+
+		bool freelist_allocate_aligned_0()
+		{
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			alignas(64) std::byte buffer[512];
+			flaff.Init(buffer);
+
+			flaff.Allocate(12);
+
+			// The padding in front of the aligned payload is big enough to be given back as a free chunk
+			void* chunk_0 = flaff.Allocate(16, 64);
+
+			std::list<FreeListAllocator::FreeListFreeHeader*> free_chunks = flaff.GetFreeChunks();
+			bool leading_chunk_freed = free_chunks.size() == 2 && free_chunks.front()->m_chunk_size == 64 - 12 - 3 * sizeof(FreeListAllocator::FreeListAllocHeader);
+
+			flaff.Free(chunk_0);
+
+			free_chunks = flaff.GetFreeChunks();
+
+			return chunk_0 == buffer + 64 && leading_chunk_freed && free_chunks.size() == 1 &&
+				   free_chunks.front()->m_chunk_size == 512 - 12 - 2 * sizeof(FreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool freelist_allocate_aligned_1()
+		{
+			FreeListAllocator flabf(FreeListAllocator::e_AllocType::e_bestfit);
+			alignas(64) std::byte buffer[512];
+			flabf.Init(buffer);
+
+			void* chunk_0 = flabf.Allocate(20);
+
+			// The padding is too small to be a free chunk, it stays in the allocated chunk
+			void* chunk_1 = flabf.Allocate(16, 32);
+			bool padding_kept = flabf.GetFreeChunks().size() == 1;
+
+			flabf.Free(chunk_1);
+			flabf.Free(chunk_1);		// Double free
+			flabf.Free(chunk_0);
+
+			std::list<FreeListAllocator::FreeListFreeHeader*> free_chunks = flabf.GetFreeChunks();
+
+			return chunk_1 == buffer + 32 && padding_kept && free_chunks.size() == 1 &&
+				   free_chunks.front()->m_chunk_size == 512 - sizeof(FreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool freelist_reallocate_0()
+		{
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			std::byte buffer[256];
+			flaff.Init(buffer);
+
+			void* chunk_0 = flaff.Allocate(64);
+			void* chunk_1 = flaff.Allocate(64);
+			flaff.Free(chunk_1);
+
+			// Grows into the next free chunk
+			void* chunk_2 = flaff.Reallocate(chunk_0, 100);
+			std::list<FreeListAllocator::FreeListFreeHeader*> free_chunks = flaff.GetFreeChunks();
+			bool grown_in_place = chunk_2 == chunk_0 && free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == 256 - 100 - 2 * sizeof(FreeListAllocator::FreeListAllocHeader);
+
+			// Shrinks and gives the rest back to the next free chunk
+			void* chunk_3 = flaff.Reallocate(chunk_2, 32);
+			free_chunks = flaff.GetFreeChunks();
+
+			return grown_in_place && chunk_3 == chunk_0 && free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == 256 - 32 - 2 * sizeof(FreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool freelist_reallocate_1()
+		{
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			std::byte buffer[256];
+			flaff.Init(buffer);
+
+			int* chunk_0 = static_cast<int*>(flaff.Allocate(4 * sizeof(int)));
+			flaff.Allocate(16);
+			for (int i = 0; i < 4; i++)
+				chunk_0[i] = i;
+
+			// The next chunk is in use so the data has to be moved
+			int* chunk_1 = static_cast<int*>(flaff.Reallocate(chunk_0, 8 * sizeof(int)));
+
+			bool data_kept = true;
+			for (int i = 0; i < 4; i++)
+				data_kept = data_kept && chunk_1[i] == i;
+
+			// Too large to fit anywhere, the old chunk is kept
+			void* chunk_2 = flaff.Reallocate(chunk_1, 1024);
+
+			return chunk_1 != chunk_0 && data_kept && chunk_2 == nullptr && flaff.GetFreeChunks().size() == 2;
+		}
+
 		bool freelist_free_0()
 		{
 			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
@@ -150,7 +291,7 @@ namespace UT
 
 			std::list<FreeListAllocator::FreeListFreeHeader*> free_chunks = flaff.GetFreeChunks();
 
-			return free_chunks.size() == 3 && free_chunks.front()->m_free_list_next->m_chunk_size == 16;
+			return free_chunks.size() == 3 && (*std::next(free_chunks.begin()))->m_chunk_size == 16;
 		}
 
 		bool freelist_free_1()
@@ -179,6 +320,51 @@ namespace UT
 			return true;
 		}
 
+		bool freelist_free_3()
+		{
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			std::byte buffer[64];
+			flaff.Init(buffer);
+
+			void* chunk_0 = flaff.Allocate(16);
+			void* chunk_1 = flaff.Allocate(16);
+
+			flaff.Free(chunk_1);
+			flaff.Free(chunk_1);	// Double free, the boundary tags tell us it is not allocated
+			flaff.Free(chunk_0);
+
+			std::list<FreeListAllocator::FreeListFreeHeader*> free_chunks = flaff.GetFreeChunks();
+
+			return free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == flaff.GetBufferSize() - sizeof(FreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool freelist_free_4()
+		{
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			alignas(16) std::byte buffer[64];
+			flaff.Init(buffer);
+
+			std::byte* chunk_0 = static_cast<std::byte*>(flaff.Allocate(32));
+
+			// Payload bytes that look like an alloc header, the next chunk's tag says it is free
+			*reinterpret_cast<unsigned*>(chunk_0) = FreeListAllocator::FLAG_IN_USE | 4u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 8) = FreeListAllocator::FLAG_PREV_FREE;
+			flaff.Free(chunk_0 + 4);
+
+			// Same with a free previous chunk, the footer doesnt match the header it points to
+			*reinterpret_cast<unsigned*>(chunk_0 + 4) = 9u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 12) = 8u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 16) = FreeListAllocator::FLAG_IN_USE | FreeListAllocator::FLAG_PREV_FREE | 4u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 24) = 0u;
+			flaff.Free(chunk_0 + 20);
+
+			const bool kept = flaff.GetStats().m_alloc_chunk_count == 1 && flaff.GetFreeChunks().size() == 1;
+
+			flaff.Free(chunk_0);
+
+			return kept && flaff.GetStats().m_alloc_chunk_count == 0 && flaff.GetFreeChunks().size() == 1;
+		}
+
 		bool freelist_clear()
 		{
 			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
@@ -194,6 +380,131 @@ namespace UT
 			return flaff.GetFreeChunks().size() == 1 && flaff.GetBufferSize() == 64;
 		}
 
+		bool freelist_stats()
+		{
+			FreeListAllocator flabf(FreeListAllocator::e_AllocType::e_bestfit);
+			std::byte buffer[256];
+			flabf.Init(buffer);
+
+			void* chunk_to_free_0 = flabf.Allocate(32);
+			flabf.Allocate(16);
+			void* chunk_to_free_1 = flabf.Allocate(64);
+			flabf.Free(chunk_to_free_0);
+
+			const FreeListAllocator::FreeListStats& stats = flabf.GetStats();
+			bool stats_kept = stats.m_bytes_in_use == 16 + 64 && stats.m_high_water_mark == 32 + 16 + 64 && stats.m_alloc_chunk_count == 2 &&
+							  stats.m_free_chunk_count == 2 && stats.m_bytes_free == 256 - 16 - 64 - 4 * sizeof(FreeListAllocator::FreeListAllocHeader) &&
+							  stats.m_free_size_classes[5] == 1 && stats.m_free_size_classes[7] == 1 && flabf.GetLargestFreeChunkLowerBound() == 128;
+
+			// The stats have to survive changing the free chunk index
+			flabf.SetAllocType(FreeListAllocator::e_AllocType::e_firstfit);
+			unsigned free_chunk_count = 0u;
+			flabf.ForEachFreeChunk([&free_chunk_count](FreeListAllocator::FreeListFreeHeader*) { free_chunk_count++; });
+			bool stats_rebuilt = free_chunk_count == 2 && stats.m_free_chunk_count == 2 && stats.m_free_size_class_bitmap == (1u << 5 | 1u << 7);
+
+			// Merges with the free chunk after it, still two free chunks
+			flabf.Free(chunk_to_free_1);
+			bool stats_merged = stats.m_bytes_in_use == 16 && stats.m_alloc_chunk_count == 1 && stats.m_free_chunk_count == 2 &&
+								stats.m_bytes_free == 256 - 16 - 3 * sizeof(FreeListAllocator::FreeListAllocHeader);
+
+			flabf.Clear();
+
+			return stats_kept && stats_rebuilt && stats_merged && stats.m_bytes_in_use == 0 && stats.m_high_water_mark == 0 && stats.m_free_chunk_count == 1 &&
+				   flabf.GetLargestFreeChunkLowerBound() == 128;
+		}
+
+		bool freelist_granularity()
+		{
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			alignas(256) std::byte buffer[1024];
+
+			// The first alloc header goes right before a granule boundary, and the chunks end on one
+			flaff.Init(std::span<std::byte>(buffer + 1, 1023), 64);
+			bool buffer_trimmed = flaff.GetGranularity() == 64 && flaff.GetBufferSize() == 960;
+
+			// Sizes are rounded up to whole granules (alloc header included) and stored in granules
+			void* chunk_0 = flaff.Allocate(20);
+			void* chunk_1 = flaff.Allocate(100);
+			void* chunk_2 = flaff.Allocate(60);
+			bool sizes_rounded = flaff.GetAllocationSize(chunk_0) == 60 && flaff.GetAllocationSize(chunk_1) == 124 && flaff.GetAllocationSize(chunk_2) == 60 &&
+								 (reinterpret_cast<FreeListAllocator::FreeListAllocHeader*>(static_cast<std::byte*>(chunk_1) - 4)->m_chunk_size & FreeListAllocator::SIZE_MASK) == 2;
+
+			bool payloads_aligned = reinterpret_cast<uintptr_t>(chunk_0) % 64 == 0 && reinterpret_cast<uintptr_t>(chunk_1) % 64 == 0 && reinterpret_cast<uintptr_t>(chunk_2) % 64 == 0;
+
+			// The padding of an aligned allocation is always a whole number of granules, so it is given back
+			void* chunk_3 = flaff.Allocate(20, 256);
+			bool aligned = chunk_3 != nullptr && reinterpret_cast<uintptr_t>(chunk_3) % 256 == 0 && flaff.GetStats().m_free_chunk_count == 2;
+
+			flaff.Free(chunk_1);
+			flaff.Free(chunk_3);
+			flaff.Free(chunk_0);
+			flaff.Free(chunk_2);
+
+			std::list<FreeListAllocator::FreeListFreeHeader*> free_chunks = flaff.GetFreeChunks();
+			bool merged = free_chunks.size() == 1 && flaff.GetChunkSize(free_chunks.front()) == 960 - 4;
+
+			// Buffers of up to 1 GiB keep plain byte sizes, larger ones get the smallest granule that fits them
+			bool granularity_picked = FreeListAllocator::CalculateGranularity(size_t(1u) << 30) == 1 && FreeListAllocator::CalculateGranularity(size_t(8u) << 30) == 16 &&
+									  FreeListAllocator::CalculateGranularity(size_t(300u) << 30) == 512;
+
+			return buffer_trimmed && sizes_rounded && payloads_aligned && aligned && merged && granularity_picked;
+		}
+
+		// Runs the same allocate & free sequence and returns the offsets of the chunks it got, -1 for failed allocations
+		template <typename Allocator>
+		static std::vector<ptrdiff_t> RunAllocationSequence(Allocator& allocator, std::byte* buffer)
+		{
+			std::vector<ptrdiff_t> result;
+			std::vector<void*> chunks;
+
+			for (int i = 0; i < 24; i++)
+			{
+				chunks.push_back(allocator.Allocate(16 + (i * 7) % 40, i % 5 == 0 ? 32 : 0));
+				if (i % 3 == 1)
+				{
+					allocator.Free(chunks[i / 2]);
+					chunks[i / 2] = nullptr;
+				}
+			}
+
+			for (void* chunk : chunks)
+				result.push_back(chunk != nullptr ? static_cast<std::byte*>(chunk) - buffer : -1);
+
+			return result;
+		}
+
+		bool freelist_policy()
+		{
+			alignas(64) std::byte buffer[1024];
+
+			// The compile time policies have to behave exactly like the runtime alloc types
+			BasicFreeListAllocator<FirstFitPolicy> flaff_static;
+			flaff_static.Init(buffer);
+			const std::vector<ptrdiff_t> firstfit_static = RunAllocationSequence(flaff_static, buffer);
+
+			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
+			flaff.Init(buffer);
+			bool firstfit_same = RunAllocationSequence(flaff, buffer) == firstfit_static && flaff.GetStats().m_free_chunk_count == flaff_static.GetStats().m_free_chunk_count;
+
+			BasicFreeListAllocator<BestFitPolicy> flabf_static;
+			flabf_static.Init(buffer);
+			const std::vector<ptrdiff_t> bestfit_static = RunAllocationSequence(flabf_static, buffer);
+
+			FreeListAllocator flabf(FreeListAllocator::e_AllocType::e_bestfit);
+			flabf.Init(buffer);
+			bool bestfit_same = RunAllocationSequence(flabf, buffer) == bestfit_static && flabf.GetSearchLength() == flabf_static.GetSearchLength();
+
+			BasicFreeListAllocator<NextFitPolicy> flanf_static;
+			flanf_static.Init(buffer);
+			const std::vector<ptrdiff_t> nextfit_static = RunAllocationSequence(flanf_static, buffer);
+
+			FreeListAllocator flanf(FreeListAllocator::e_AllocType::e_nextfit);
+			flanf.Init(buffer);
+			bool nextfit_same = RunAllocationSequence(flanf, buffer) == nextfit_static && flanf.GetSearchLength() == flanf_static.GetSearchLength();
+
+			return firstfit_same && bestfit_same && nextfit_same && firstfit_static != bestfit_static;
+		}
+
 		bool freelist_prod()
 		{
 			FreeListAllocator flaff(FreeListAllocator::e_AllocType::e_firstfit);
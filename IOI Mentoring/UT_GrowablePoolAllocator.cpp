@@ -0,0 +1,161 @@
+/***************************************************************************//**
+ * @filename UT_GrowablePoolAllocator.cpp
+ * @brief	 Contains the growable pool allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "GrowablePoolAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool growablepool_init()
+		{
+			GrowablePoolAllocator gpa;
+			gpa.Init(16, 256);
+
+			// No slabs until the first allocation
+			return gpa.GetChunkSize() == 16 && gpa.GetSlabSize() == 256 && gpa.GetSlabCount() == 0 && gpa.GetFreeChunkAmount() == 0;
+		}
+
+		bool growablepool_allocate_0()
+		{
+			GrowablePoolAllocator gpa;
+			gpa.Init(16, 256);
+
+			// 16 chunks per slab, the 17th needs a second slab
+			std::vector<void*> chunks;
+			for (int i = 0; i < 17; i++)
+				chunks.push_back(gpa.Allocate());
+
+			// Both slabs are aligned to their size
+			bool slabs_aligned = reinterpret_cast<uintptr_t>(chunks[0]) % 256 == 0 && reinterpret_cast<uintptr_t>(chunks[16]) % 256 == 0;
+
+			bool all_valid = std::all_of(chunks.begin(), chunks.end(), [&gpa](void* chunk) { return gpa.IsChunkPtrValid(chunk) && !gpa.IsChunkFree(chunk); });
+
+			return gpa.GetSlabCount() == 2 && gpa.GetFreeChunkAmount() == 15 && slabs_aligned && all_valid;
+		}
+
+		bool growablepool_allocate_1()
+		{
+			std::vector<std::byte> buffer(4096);
+			FreeListAllocator fla;
+			fla.Init(buffer);
+			FreeListSlabSource upstream(fla);
+
+			// The upstream allocator has room for a couple of 1 KiB slabs once they are aligned, then it runs out
+			GrowablePoolAllocator gpa;
+			gpa.Init(64, 1024, upstream);
+
+			std::vector<void*> chunks;
+			for (void* chunk = gpa.Allocate(); chunk != nullptr; chunk = gpa.Allocate())
+				chunks.push_back(chunk);
+
+			bool ran_out = gpa.GetSlabCount() >= 2 && chunks.size() == gpa.GetSlabCount() * 16u && gpa.GetFreeChunkAmount() == 0;
+
+			for (void* chunk : chunks)
+				gpa.Free(chunk);
+
+			// Only one free slab is kept, the others went back upstream
+			return ran_out && gpa.GetSlabCount() == 1 && fla.GetStats().m_alloc_chunk_count == 1;
+		}
+
+		bool growablepool_free_0()
+		{
+			GrowablePoolAllocator gpa;
+			gpa.Init(16, 256, HeapSlabSource::Get(), 1);
+
+			std::vector<void*> chunks;
+			for (int i = 0; i < 48; i++)
+				chunks.push_back(gpa.Allocate());
+
+			// Emptying the first slab keeps it, emptying the second one gives it back
+			for (int i = 0; i < 16; i++)
+				gpa.Free(chunks[i]);
+			bool first_kept = gpa.GetSlabCount() == 3 && gpa.GetFreeChunkAmount() == 16;
+
+			for (int i = 16; i < 32; i++)
+				gpa.Free(chunks[i]);
+			bool second_released = gpa.GetSlabCount() == 2 && gpa.GetFreeChunkAmount() == 16;
+
+			// Allocating again uses the free slab instead of growing
+			void* chunk_0 = gpa.Allocate();
+			bool reused = gpa.GetSlabCount() == 2 && (chunk_0 == chunks[15] || chunk_0 == chunks[31]);
+
+			gpa.Free(chunk_0);
+			for (int i = 32; i < 48; i++)
+				gpa.Free(chunks[i]);
+
+			return first_kept && second_released && reused && gpa.GetSlabCount() == 1 && gpa.GetFreeChunkAmount() == 16;
+		}
+
+		bool growablepool_free_1()
+		{
+			GrowablePoolAllocator gpa;
+			gpa.Init(16, 256);
+
+			void* chunk_0 = gpa.Allocate();
+			void* chunk_1 = gpa.Allocate();
+			gpa.Free(chunk_0);
+
+			// Invalid ptrs and double frees are ignored
+			int* temp_ptr = new int;
+			gpa.Free(static_cast<void*>(temp_ptr));
+			delete temp_ptr;
+			gpa.Free(static_cast<std::byte*>(chunk_1) + 2);
+			gpa.Free(chunk_0);
+
+			return gpa.GetFreeChunkAmount() == 15 && gpa.IsChunkFree(chunk_0) && !gpa.IsChunkFree(chunk_1) &&
+				   !gpa.IsChunkPtrValid(static_cast<std::byte*>(chunk_1) + 2);
+		}
+
+		bool growablepool_clear()
+		{
+			GrowablePoolAllocator gpa;
+			gpa.Init(16, 256, HeapSlabSource::Get(), 2);
+
+			for (int i = 0; i < 64; i++)
+				gpa.Allocate();
+
+			// Only the allowed amount of free slabs are kept
+			gpa.Clear();
+
+			return gpa.GetSlabCount() == 2 && gpa.GetFreeChunkAmount() == 32 && gpa.Allocate() != nullptr && gpa.GetSlabCount() == 2;
+		}
+
+		bool growablepool_prod()
+		{
+			GrowablePoolAllocator gpa;
+			gpa.Init(sizeof(AllocatorTestClass), 1024);
+
+			AllocatorTestClass* data_0 = new (gpa.Allocate()) AllocatorTestClass(1.2, 8);
+
+			// Grow well past the first slab, keep every other chunk
+			std::vector<AllocatorTestClass*> chunks;
+			for (int i = 0; i < 1000; i++)
+			{
+				chunks.push_back(new (gpa.Allocate()) AllocatorTestClass(i * 0.5, i));
+				if (i % 2 == 1)
+				{
+					gpa.Free(chunks.back());
+					chunks.pop_back();
+				}
+			}
+
+			bool data_kept = *data_0 == AllocatorTestClass(1.2, 8);
+			for (size_t i = 0; i < chunks.size(); i++)
+				data_kept = data_kept && *chunks[i] == AllocatorTestClass(i * 2 * 0.5, static_cast<int>(i * 2));
+
+			for (AllocatorTestClass* chunk : chunks)
+				gpa.Free(chunk);
+			gpa.Free(data_0);
+
+			return data_kept && gpa.GetSlabCount() == 1;
+		}
+	}
+}
@@ -7,6 +7,7 @@
 #include "pch.h"
 #include "UnitTests.h"
 #include "LinearAllocator.h"
+#include "ScopedArena.h"
 #include "AllocatorTestClass.h"
 
 namespace UT
@@ -25,24 +26,56 @@ namespace UT
         bool linear_allocate_0()
         {
             LinearAllocator la;
-            std::byte buffer[48]; 
+            alignas(8) std::byte buffer[48];
             la.Init(buffer);
 
             la.Allocate(20, 4);
 
-            return la.GetOffset() == 20 + (20 % 4);
+            return la.GetOffset() == 20;
         }
 
         bool linear_allocate_1()
         {
             LinearAllocator la;
-            std::byte buffer[48];
+            alignas(8) std::byte buffer[48];
             la.Init(buffer);
 
             la.Allocate(20, 8);
             la.Allocate(30);
 
-            return la.GetOffset() == 20 + (20 % 8);
+            return la.GetOffset() == 20;
+        }
+
+        bool linear_align_0()
+        {
+            LinearAllocator la;
+            alignas(64) std::byte buffer[256];
+            la.Init(buffer);
+
+            // The padding goes in front, from an odd offset up to the next aligned address
+            la.Allocate(1);
+            std::byte* data_0 = static_cast<std::byte*>(la.Allocate(8, 16));
+            std::byte* data_1 = static_cast<std::byte*>(la.Allocate(8, 32));
+            std::byte* data_2 = static_cast<std::byte*>(la.Allocate(8, 64));
+
+            return data_0 == &buffer[16] && data_1 == &buffer[32] && data_2 == &buffer[64] && la.GetOffset() == 72 &&
+                   la.Allocate(8, 24) == nullptr && la.GetOffset() == 72;
+        }
+
+        bool linear_align_1()
+        {
+            LinearAllocator la;
+            alignas(64) std::byte buffer[256];
+            la.Init(buffer);
+
+            // Same as the runtime alignment with the mask known at compile time
+            la.Allocate(1);
+            std::byte* data_0 = static_cast<std::byte*>(la.Allocate<16>(8));
+            std::byte* data_1 = static_cast<std::byte*>(la.Allocate<64>(8));
+            void* data_2 = la.Allocate<64>(256);
+
+            return data_0 == &buffer[16] && data_1 == &buffer[64] && data_2 == nullptr && la.GetOffset() == 72 &&
+                   IAllocator::CalculatePadding(17, 16) == 15 && IAllocator::CalculatePadding<8>(16) == 0 && IAllocator::AlignForward(33, 32) == 64;
         }
 
         bool linear_free_0()
@@ -57,10 +90,50 @@ namespace UT
             return la.GetOffset() == 0 && la.GetBufferSize() == 48;
         }
 
+        bool linear_marker()
+        {
+            LinearAllocator la;
+            std::byte buffer[48];
+            la.Init(buffer);
+
+            la.Allocate(8);
+            const LinearAllocator::Marker marker = la.GetMarker();
+            la.Allocate(16);
+            la.Allocate(8);
+
+            // Rewinds past both allocations, a marker past the offset is ignored
+            la.FreeToMarker(marker);
+            la.FreeToMarker(40);
+
+            return marker == 8 && la.GetOffset() == 8 && la.Allocate(40) == &buffer[8];
+        }
+
+        bool linear_scoped()
+        {
+            LinearAllocator la;
+            std::byte buffer[48];
+            la.Init(buffer);
+
+            la.Allocate(8);
+            bool nested_rewound = false;
+            {
+                ScopedArena<LinearAllocator> outer(la);
+                outer.Allocate(8);
+                {
+                    ScopedArena<LinearAllocator> inner(la);
+                    inner.Allocate(16);
+                    la.Allocate(8);
+                }
+                nested_rewound = la.GetOffset() == 16;
+            }
+
+            return nested_rewound && la.GetOffset() == 8;
+        }
+
         bool linear_prod()
         {
             LinearAllocator la;
-            std::byte buffer[sizeof(AllocatorTestClass) * 8];
+            alignas(AllocatorTestClass) std::byte buffer[sizeof(AllocatorTestClass) * 8];
             la.Init(buffer);
 
             AllocatorTestClass* data_0 = new (la.Allocate(sizeof(AllocatorTestClass), 4)) AllocatorTestClass(1.2, 8);
@@ -0,0 +1,198 @@
+/***************************************************************************//**
+ * @filename UT_ObjectPool.cpp
+ * @brief	 Contains the object pool unit test function implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "ObjectPool.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		// Counts the objects alive so the tests can check every constructor has its destructor
+		class ObjectPoolTestClass
+		{
+		public:
+			ObjectPoolTestClass(const int& id) : m_id(id)
+			{
+				s_alive++;
+			}
+
+			~ObjectPoolTestClass()
+			{
+				s_alive--;
+			}
+
+			int m_id = 0;
+
+			static inline int s_alive = 0;
+		};
+
+		struct alignas(64) ObjectPoolAlignedClass
+		{
+			int m_id = 0;
+		};
+
+		bool objectpool_init()
+		{
+			ObjectPool<AllocatorTestClass> op;
+			alignas(16) std::byte buffer[16 * 10 + 8];
+			op.Init(buffer);
+
+			// Chunk size and alignment come from the type, the buffer is trimmed to a whole number of chunks
+			bool sizes = ObjectPool<AllocatorTestClass>::CHUNK_SIZE == 16 && ObjectPool<AllocatorTestClass>::CHUNK_ALIGNMENT == 8 &&
+						 ObjectPool<int>::CHUNK_SIZE == 4 && ObjectPool<int16_t>::CHUNK_SIZE == 4 && ObjectPool<ObjectPoolAlignedClass>::CHUNK_SIZE == 64;
+
+			// Over aligned types skip the start of the buffer
+			ObjectPool<ObjectPoolAlignedClass> aligned_op;
+			alignas(64) std::byte aligned_buffer[64 * 4];
+			aligned_op.Init(std::span<std::byte>(aligned_buffer + 1, 64 * 3));
+
+			return sizes && op.GetCapacity() == 10 && op.GetLiveCount() == 0 && aligned_op.GetCapacity() == 2;
+		}
+
+		bool objectpool_create()
+		{
+			ObjectPool<AllocatorTestClass> op;
+			std::vector<std::byte> buffer(16 * 4);
+			op.Init(buffer);
+
+			ObjectPool<AllocatorTestClass>::Handle handle_0 = op.Create(1.5, 3);
+			ObjectPool<AllocatorTestClass>::Handle handle_1 = op.Create(2.5, 4);
+
+			// Handles are a 32-bit index + generation, the generation of a chunk that holds an object is odd
+			bool handles = sizeof(handle_0) == 4 && handle_0.GetIndex() == 0 && handle_1.GetIndex() == 1 && handle_0.GetGeneration() % 2 == 1;
+
+			bool constructed = *op.Get(handle_0) == AllocatorTestClass(1.5, 3) && *op.Get(handle_1) == AllocatorTestClass(2.5, 4);
+
+			// Full
+			op.Create(0.0, 0);
+			op.Create(0.0, 0);
+			ObjectPool<AllocatorTestClass>::Handle handle_4 = op.Create(0.0, 0);
+
+			return handles && constructed && handle_4.IsNull() && op.Get(handle_4) == nullptr && op.GetLiveCount() == 4 &&
+				   op.GetHandle(op.Get(handle_1)) == handle_1;
+		}
+
+		bool objectpool_destroy()
+		{
+			ObjectPoolTestClass::s_alive = 0;
+
+			ObjectPool<ObjectPoolTestClass> op;
+			std::vector<std::byte> buffer(ObjectPool<ObjectPoolTestClass>::CHUNK_SIZE * 8);
+			op.Init(buffer);
+
+			// A zeroed handle has the even generation of a chunk that was never used
+			const bool zero_rejected = !op.IsValid(ObjectPool<ObjectPoolTestClass>::Handle{ 0u }) && op.Get(ObjectPool<ObjectPoolTestClass>::Handle{ 5u }) == nullptr;
+
+			ObjectPool<ObjectPoolTestClass>::Handle handle_0 = op.Create(10);
+			ObjectPool<ObjectPoolTestClass>::Handle handle_1 = op.Create(11);
+			op.Destroy(handle_0);
+
+			bool destroyed = zero_rejected && ObjectPoolTestClass::s_alive == 1 && !op.IsValid(handle_0) && op.Get(handle_1)->m_id == 11;
+
+			// The chunk is reused with a new generation, the old handle stays stale
+			ObjectPool<ObjectPoolTestClass>::Handle handle_2 = op.Create(12);
+			bool reused = handle_2.GetIndex() == handle_0.GetIndex() && !(handle_2 == handle_0) && op.Get(handle_0) == nullptr &&
+						  op.Get(handle_2)->m_id == 12;
+
+			// Stale and null handles are ignored
+			op.Destroy(handle_0);
+			op.Destroy(ObjectPool<ObjectPoolTestClass>::Handle{});
+
+			bool kept = ObjectPoolTestClass::s_alive == 2 && op.GetLiveCount() == 2;
+
+			op.Destroy(handle_1);
+			op.Destroy(handle_2);
+
+			return destroyed && reused && kept && ObjectPoolTestClass::s_alive == 0 && op.GetLiveCount() == 0;
+		}
+
+		bool objectpool_generation()
+		{
+			// 4 generation bits, a chunk can be reused 8 times before a handle to it can be valid again
+			ObjectPool<int, 28> op;
+			std::vector<std::byte> buffer(ObjectPool<int, 28>::CHUNK_SIZE);
+			op.Init(buffer);
+
+			ObjectPool<int, 28>::Handle first_handle = op.Create(0);
+			op.Destroy(first_handle);
+
+			bool stale = true;
+			for (int i = 1; i < 8; i++)
+			{
+				ObjectPool<int, 28>::Handle handle = op.Create(i);
+				stale = stale && !op.IsValid(first_handle) && handle.GetGeneration() % 2 == 1;
+				op.Destroy(handle);
+			}
+
+			// The generation has wrapped around
+			ObjectPool<int, 28>::Handle wrapped_handle = op.Create(8);
+
+			return stale && wrapped_handle == first_handle;
+		}
+
+		bool objectpool_foreach()
+		{
+			ObjectPool<AllocatorTestClass> op;
+			std::vector<std::byte> buffer(16 * 200);
+			op.Init(buffer);
+
+			std::vector<ObjectPool<AllocatorTestClass>::Handle> handles;
+			for (int i = 0; i < 150; i++)
+				handles.push_back(op.Create(i * 0.5, i));
+
+			// Every third one is destroyed
+			for (int i = 0; i < 150; i += 3)
+				op.Destroy(handles[i]);
+
+			// Live objects in address order, they can be destroyed while iterating
+			std::vector<int> visited;
+			bool handles_match = true;
+			op.ForEach([&op, &visited, &handles_match](const ObjectPool<AllocatorTestClass>::Handle& handle, AllocatorTestClass& object)
+				{
+					visited.push_back(object.x);
+					handles_match = handles_match && op.Get(handle) == &object;
+					if (object.x % 3 == 1)
+						op.Destroy(handle);
+				});
+
+			bool all_visited = visited.size() == 100;
+			for (size_t i = 0; i < visited.size(); i++)
+				all_visited = all_visited && visited[i] == static_cast<int>(i / 2 * 3 + 1 + i % 2);
+
+			return all_visited && handles_match && op.GetLiveCount() == 50;
+		}
+
+		bool objectpool_clear()
+		{
+			ObjectPoolTestClass::s_alive = 0;
+
+			ObjectPool<ObjectPoolTestClass>::Handle handle_0;
+			{
+				ObjectPool<ObjectPoolTestClass> op;
+				std::vector<std::byte> buffer(ObjectPool<ObjectPoolTestClass>::CHUNK_SIZE * 8);
+				op.Init(buffer);
+
+				handle_0 = op.Create(1);
+				op.Create(2);
+				op.Clear();
+
+				// Every object is destroyed and their handles are stale
+				bool cleared = ObjectPoolTestClass::s_alive == 0 && !op.IsValid(handle_0) && op.GetLiveCount() == 0;
+
+				op.Create(3);
+				op.Create(4);
+				if (!cleared)
+					return false;
+			}
+
+			// And the objects left are destroyed with the pool
+			return ObjectPoolTestClass::s_alive == 0;
+		}
+	}
+}
@@ -45,7 +45,15 @@ namespace UT
 
             void* chunk_13 = pa.Allocate();
 
-            return pa.GetFreeChunkAmount() == 0 && chunk_13 == nullptr;
+            // Pools that were never initialized or whose Init failed have no chunks
+            PoolAllocator pa_empty;
+            void* chunk_empty_0 = pa_empty.Allocate();
+            pa_empty.Init(buffer, 0);
+            void* chunk_empty_1 = pa_empty.Allocate();
+            std::array<void*, 2> chunks_empty{};
+
+            return pa.GetFreeChunkAmount() == 0 && chunk_13 == nullptr && chunk_empty_0 == nullptr && chunk_empty_1 == nullptr &&
+                   pa_empty.AllocateN(chunks_empty) == 0 && pa_empty.GetFreeChunkAmount() == 0;
         }
 
         bool pool_free_0()
@@ -87,6 +95,249 @@ namespace UT
             return pa.GetFreeChunkAmount() == 11;
         }
 
+        bool pool_free_3()
+        {
+            PoolAllocator pa;
+            std::byte buffer[1024];
+            pa.Init(buffer, 8);
+
+            std::vector<void*> chunks;
+            for (unsigned i = 0u; i < 100; i++)
+                chunks.push_back(pa.Allocate());
+
+            pa.Free(chunks[70]);
+            pa.Free(chunks[3]);
+
+            // Double frees and ptrs past the end of the buffer are caught without walking the free list
+            pa.Free(chunks[70]);
+            pa.Free(buffer + 1024);
+
+            return pa.GetFreeChunkAmount() == 30 && pa.IsChunkFree(chunks[70]) && pa.IsChunkFree(chunks[3]) && !pa.IsChunkFree(chunks[4]) &&
+                   pa.Allocate() == chunks[3] && pa.Allocate() == chunks[70];
+        }
+
+        bool pool_batch_0()
+        {
+            PoolAllocator pa;
+            std::byte buffer[1024];
+            pa.Init(buffer, 16);
+
+            void* chunk_0 = pa.Allocate();
+            void* chunk_1 = pa.Allocate();
+            pa.Free(chunk_1);
+            pa.Free(chunk_0);
+
+            // The two freed chunks come off the free list, the rest are the never used chunks in order
+            std::array<void*, 6> chunks{};
+            unsigned count = pa.AllocateN(chunks);
+
+            bool in_order = chunks[0] == chunk_0 && chunks[1] == chunk_1;
+            for (unsigned i = 2u; i < 6u; i++)
+                in_order = in_order && chunks[i] == buffer + i * 16;
+
+            bool allocated = std::none_of(chunks.begin(), chunks.end(), [&pa](void* chunk) { return pa.IsChunkFree(chunk); });
+
+            // Only what is left is handed out
+            std::array<void*, 64> rest{};
+            unsigned rest_count = pa.AllocateN(rest);
+
+            return count == 6 && in_order && allocated && pa.IsChunkFree(buffer + 6 * 16) == false && rest_count == 58 &&
+                   rest[57] == buffer + 63 * 16 && pa.GetFreeChunkAmount() == 0;
+        }
+
+        bool pool_batch_1()
+        {
+            PoolAllocator pa;
+            std::byte buffer[1024];
+            pa.Init(buffer, 16);
+
+            std::array<void*, 10> chunks{};
+            pa.AllocateN(chunks);
+
+            // Invalid ptrs and ptrs that are there twice are skipped
+            int* temp_ptr = new int;
+            std::array<void*, 6> to_free = { chunks[2], chunks[5], temp_ptr, chunks[2], buffer + 3, chunks[7] };
+            pa.FreeN(to_free);
+            delete temp_ptr;
+
+            bool freed = pa.GetFreeChunkAmount() == 57 && pa.IsChunkFree(chunks[2]) && pa.IsChunkFree(chunks[5]) && pa.IsChunkFree(chunks[7]) &&
+                         !pa.IsChunkFree(chunks[3]);
+
+            // The last freed chunk is the new head of the free list
+            std::array<void*, 3> reused{};
+            pa.AllocateN(reused);
+
+            return freed && reused[0] == chunks[7] && reused[1] == chunks[5] && reused[2] == chunks[2];
+        }
+
+        bool pool_tiny_0()
+        {
+            PoolAllocator pa;
+            std::byte buffer[6 * 100];
+            pa.Init(buffer, 6);
+
+            // Up to 65535 chunks the links are 16 bits, so 6 byte chunks work even though their links arent aligned
+            std::vector<void*> chunks;
+            for (unsigned i = 0u; i < 100; i++)
+                chunks.push_back(pa.Allocate());
+
+            for (unsigned i = 0u; i < 100; i += 2)
+                pa.Free(chunks[i]);
+
+            bool reused = pa.GetFreeChunkAmount() == 50 && pa.Allocate() == chunks[98] && pa.Allocate() == chunks[96];
+
+            // 2 byte chunks are the smallest ones
+            PoolAllocator small_pa;
+            small_pa.Init(std::span<std::byte>(buffer, 2 * 100), 2);
+            void* chunk_0 = small_pa.Allocate();
+            void* chunk_1 = small_pa.Allocate();
+            small_pa.Free(chunk_0);
+
+            return reused && small_pa.GetChunkSize() == 2 && chunk_1 == buffer + 2 && small_pa.Allocate() == chunk_0;
+        }
+
+        bool pool_tiny_1()
+        {
+            // More than 65535 chunks need 32-bit links
+            std::vector<std::byte> buffer(4 * 70000);
+            PoolAllocator pa;
+            pa.Init(buffer, 4);
+
+            PoolAllocator too_small_pa;
+            too_small_pa.Init(std::span<std::byte>(buffer.data(), 2 * 70000), 2);
+
+            std::vector<void*> chunks(70000);
+            unsigned count = pa.AllocateN(chunks);
+
+            // Free a chunk past index 65535 and one before it
+            pa.Free(chunks[69999]);
+            pa.Free(chunks[65535]);
+            pa.Free(chunks[3]);
+
+            return count == 70000 && too_small_pa.GetChunkSize() == 0 && pa.Allocate() == chunks[3] && pa.Allocate() == chunks[65535] &&
+                   pa.Allocate() == chunks[69999] && pa.Allocate() == nullptr;
+        }
+
+        bool pool_relocate()
+        {
+            PoolAllocator pa;
+            std::byte buffer[128];
+            pa.Init(buffer, 8);
+
+            std::array<void*, 6> chunks{};
+            pa.AllocateN(chunks);
+            pa.Free(chunks[1]);
+            pa.Free(chunks[4]);
+
+            // Copy the buffer somewhere else and move the same pool to it, the free list is made of indices so it doesnt need fixing up
+            std::byte moved_buffer[128];
+            std::memcpy(moved_buffer, buffer, sizeof(buffer));
+            std::memset(buffer, 0xCD, sizeof(buffer));
+            pa.Relocate(moved_buffer);
+
+            return pa.GetFreeChunkAmount() == 12 && pa.IsChunkFree(moved_buffer + 8) && !pa.IsChunkFree(moved_buffer) &&
+                   pa.Allocate() == moved_buffer + 4 * 8 && pa.Allocate() == moved_buffer + 8 && pa.Allocate() == moved_buffer + 6 * 8;
+        }
+
+        bool pool_open()
+        {
+            PoolAllocator pa;
+            alignas(PoolAllocator::PoolHeader) std::byte buffer[PoolAllocator::HEADER_SIZE + 128 + 4];
+            pa.InitWithHeader(buffer, 8);
+            std::byte* chunks_begin = buffer + PoolAllocator::HEADER_SIZE;
+
+            std::array<void*, 6> chunks{};
+            pa.AllocateN(chunks);
+            pa.Free(chunks[1]);
+            pa.Free(chunks[4]);
+
+            // The bytes after the last whole chunk are not used
+            const bool init = pa.HasHeaderInBuffer() && pa.GetBufferSize() == 128 && chunks[0] == chunks_begin;
+
+            // Another pool opens a copy of the buffer, it only has what the buffer has
+            alignas(PoolAllocator::PoolHeader) std::byte copied_buffer[sizeof(buffer)];
+            std::memcpy(copied_buffer, buffer, sizeof(buffer));
+            std::memset(buffer, 0xCD, sizeof(buffer));
+            std::byte* copied_chunks = copied_buffer + PoolAllocator::HEADER_SIZE;
+
+            PoolAllocator opened;
+            opened.Open(copied_buffer);
+            const bool open = opened.GetChunkCount() == 16 && opened.GetChunkSize() == 8 && opened.GetFreeChunkAmount() == 12 &&
+                              opened.IsChunkFree(copied_chunks + 8) && !opened.IsChunkFree(copied_chunks) && opened.IsChunkFree(copied_chunks + 6 * 8);
+
+            // Same order the original pool would have given
+            const bool order = opened.Allocate() == copied_chunks + 4 * 8 && opened.Allocate() == copied_chunks + 8 && opened.Allocate() == copied_chunks + 6 * 8;
+
+            // Relocating a pool with a header moves the header too
+            alignas(PoolAllocator::PoolHeader) std::byte moved_buffer[sizeof(buffer)];
+            std::memcpy(moved_buffer, copied_buffer, sizeof(buffer));
+            opened.Relocate(moved_buffer);
+            const bool relocate = opened.GetFreeChunkAmount() == 9 && opened.Allocate() == moved_buffer + PoolAllocator::HEADER_SIZE + 7 * 8;
+
+            // A wrong magic or a free list that loops are rejected, the pool is left without chunks
+            std::memcpy(copied_buffer, moved_buffer, sizeof(buffer));
+            copied_buffer[0] ^= std::byte{ 1 };
+            PoolAllocator corrupt_magic;
+            corrupt_magic.Open(copied_buffer);
+
+            std::memcpy(copied_buffer, moved_buffer, sizeof(buffer));
+            opened.Free(moved_buffer + PoolAllocator::HEADER_SIZE);
+            opened.Free(moved_buffer + PoolAllocator::HEADER_SIZE + 8);
+            std::memcpy(copied_buffer, moved_buffer, sizeof(buffer));
+            const uint16_t self_link = 1;
+            std::memcpy(copied_chunks + 8, &self_link, sizeof(self_link));
+            PoolAllocator corrupt_list;
+            corrupt_list.Open(copied_buffer);
+
+            return init && open && order && relocate && corrupt_magic.GetChunkCount() == 0 && corrupt_magic.Allocate() == nullptr &&
+                   corrupt_list.GetChunkCount() == 0 && corrupt_list.Allocate() == nullptr && !corrupt_list.HasHeaderInBuffer();
+        }
+
+        bool pool_align_0()
+        {
+            PoolAllocator pa;
+            alignas(32) std::byte buffer[32 * 8];
+
+            // The buffer starts 4 bytes past a 32 byte boundary, the first chunk is at the next one and 20 byte chunks take 32
+            pa.Init(std::span<std::byte>(buffer + 4, sizeof(buffer) - 4), 20, 32);
+
+            std::vector<void*> chunks;
+            for (void* chunk = pa.Allocate(); chunk != nullptr; chunk = pa.Allocate())
+                chunks.push_back(chunk);
+
+            bool aligned = std::all_of(chunks.begin(), chunks.end(), [](void* chunk) { return reinterpret_cast<uintptr_t>(chunk) % 32 == 0; });
+
+            // Not a power of two
+            PoolAllocator bad_pa;
+            bad_pa.Init(buffer, 8, 24);
+
+            return aligned && pa.GetChunkSize() == 32 && chunks.size() == 7 && chunks[0] == buffer + 32 && bad_pa.GetChunkSize() == 0;
+        }
+
+        bool pool_align_1()
+        {
+            PoolAllocator pa;
+            std::vector<std::byte> buffer(64 * 20);
+
+            // Isolated chunks take whole cache lines, even the small ones
+            pa.Init(buffer, 8, 0, true);
+
+            std::vector<uintptr_t> lines;
+            for (void* chunk = pa.Allocate(); chunk != nullptr; chunk = pa.Allocate())
+            {
+                lines.push_back(reinterpret_cast<uintptr_t>(chunk) / PoolAllocator::CACHE_LINE_SIZE);
+                if (reinterpret_cast<uintptr_t>(chunk) % PoolAllocator::CACHE_LINE_SIZE != 0)
+                    return false;
+            }
+
+            // No two chunks on the same line, 100 byte chunks take two
+            PoolAllocator large_pa;
+            large_pa.Init(buffer, 100, 0, true);
+
+            return pa.GetChunkSize() == PoolAllocator::CACHE_LINE_SIZE && std::adjacent_find(lines.begin(), lines.end()) == lines.end() &&
+                   lines.size() >= 19 && large_pa.GetChunkSize() == 2 * PoolAllocator::CACHE_LINE_SIZE;
+        }
+
         bool pool_clear()
         {
             PoolAllocator pa;
@@ -99,6 +350,31 @@ namespace UT
             return pa.GetFreeChunkAmount() == 12;
         }
 
+        bool pool_clear_lazy()
+        {
+            PoolAllocator pa;
+            std::byte buffer[1024];
+            std::fill(std::begin(buffer), std::end(buffer), std::byte{ 0xCD });
+            pa.Init(buffer, 16);
+
+            // Init doesnt write to the chunks, they are only carved when they are first allocated
+            bool untouched = std::all_of(std::begin(buffer), std::end(buffer), [](const std::byte& b) { return b == std::byte{ 0xCD }; });
+
+            void* chunk_0 = pa.Allocate();
+            void* chunk_1 = pa.Allocate();
+            pa.Free(chunk_0);
+
+            // The freed chunk is reused first, then the never used ones in order
+            bool reused = pa.Allocate() == chunk_0 && pa.Allocate() == buffer + 32;
+
+            // Chunks allocated before the Clear count as free after it, without resetting the bitmap
+            pa.Clear();
+            bool cleared = pa.GetFreeChunkAmount() == 64 && pa.IsChunkFree(chunk_1) && pa.IsChunkFree(buffer + 32);
+            pa.Free(chunk_1);
+
+            return untouched && reused && cleared && pa.GetFreeChunkAmount() == 64 && pa.Allocate() == buffer;
+        }
+
         bool pool_prod()
         {
             PoolAllocator pa;
@@ -0,0 +1,188 @@
+/***************************************************************************//**
+ * @filename UT_SegregatedFreeListAllocator.cpp
+ * @brief	 Contains the segregated fit free list allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "SegregatedFreeListAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool segfreelist_init()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[16];
+			sfla.Init(buffer);
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return sfla.GetBufferSize() == 16 && free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == 16 - sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool segfreelist_allocate_0()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[64];
+			sfla.Init(buffer);
+
+			sfla.Allocate(12);
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == 64 - 12 - 2 * sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool segfreelist_allocate_1()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[64];
+			sfla.Init(buffer);
+
+			void* chunk_0 = sfla.Allocate(25);
+			void* chunk_1 = sfla.Allocate(25);
+			void* chunk_2 = sfla.Allocate(4);
+
+			return chunk_0 != nullptr && chunk_1 != nullptr && chunk_2 == nullptr && sfla.GetFreeChunks().empty();
+		}
+
+		bool segfreelist_allocate_2()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[2048];
+			sfla.Init(buffer);
+
+			void* chunk_to_free_0 = sfla.Allocate(100);
+			sfla.Allocate(16);
+			void* chunk_to_free_1 = sfla.Allocate(300);
+			sfla.Allocate(16);
+
+			sfla.Free(chunk_to_free_0);
+			sfla.Free(chunk_to_free_1);
+
+			// Too large for the 100 byte bin, has to come from the 300 byte chunk and not from the end of the buffer
+			void* chunk_0 = sfla.Allocate(200);
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return chunk_0 == chunk_to_free_1 && free_chunks.size() == 3 && free_chunks.front()->m_chunk_size == 100 &&
+				   (*std::next(free_chunks.begin()))->m_chunk_size == 300 - 200 - sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool segfreelist_free_0()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[128];
+			sfla.Init(buffer);
+
+			void* chunk_to_free_0 = sfla.Allocate(16);
+			void* chunk_to_free_1 = sfla.Allocate(16);
+			void* chunk_to_free_2 = sfla.Allocate(16);
+			sfla.Allocate(12);
+
+			// Merge forward, then backwards, then both
+			sfla.Free(chunk_to_free_1);
+			sfla.Free(chunk_to_free_2);
+			bool merged_forward = sfla.GetFreeChunks().size() == 2;
+			sfla.Free(chunk_to_free_0);
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return merged_forward && free_chunks.size() == 2 && free_chunks.front()->m_chunk_size == 16 * 3 + 2 * sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool segfreelist_free_1()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[64];
+			sfla.Init(buffer);
+
+			void* chunk_0 = sfla.Allocate(16);
+
+			int* temp_ptr = new int;
+			sfla.Free(static_cast<void*>(temp_ptr));
+			delete temp_ptr;
+
+			sfla.Free(chunk_0);
+			sfla.Free(chunk_0);		// Double free
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == 64 - sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool segfreelist_free_2()
+		{
+			SegregatedFreeListAllocator sfla;
+			alignas(16) std::byte buffer[64];
+			sfla.Init(buffer);
+
+			std::byte* chunk_0 = static_cast<std::byte*>(sfla.Allocate(32));
+
+			// Payload bytes that look like an alloc header, the next chunk's tag says it is free
+			*reinterpret_cast<unsigned*>(chunk_0) = SegregatedFreeListAllocator::FLAG_IN_USE | 4u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 8) = SegregatedFreeListAllocator::FLAG_PREV_FREE;
+			sfla.Free(chunk_0 + 4);
+
+			// Same with a free previous chunk, the footer doesnt match the header it points to
+			*reinterpret_cast<unsigned*>(chunk_0 + 4) = 9u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 12) = 8u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 16) = SegregatedFreeListAllocator::FLAG_IN_USE | SegregatedFreeListAllocator::FLAG_PREV_FREE | 4u;
+			*reinterpret_cast<unsigned*>(chunk_0 + 24) = 0u;
+			sfla.Free(chunk_0 + 20);
+
+			const bool kept = sfla.GetFreeChunks().size() == 1;
+
+			sfla.Free(chunk_0);
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return kept && free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == 64 - sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+
+		bool segfreelist_clear()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[64];
+			sfla.Init(buffer);
+
+			void* chunk_to_free = sfla.Allocate(16);
+			sfla.Allocate(12);
+			sfla.Free(chunk_to_free);
+
+			sfla.Clear();
+
+			return sfla.GetFreeChunks().size() == 1 && sfla.GetBufferSize() == 64;
+		}
+
+		bool segfreelist_prod()
+		{
+			SegregatedFreeListAllocator sfla;
+			std::byte buffer[4096];
+			sfla.Init(buffer);
+			std::vector<AllocatorTestClass*> chunks;
+
+			for (int i = 0; i < 64; i++)
+				chunks.push_back(new (sfla.Allocate(sizeof(AllocatorTestClass) * (1 + i % 5))) AllocatorTestClass(i * 0.5, i));
+
+			for (size_t i = 0; i < chunks.size(); i += 2)
+				sfla.Free(chunks[i]);
+
+			bool data_kept = true;
+			for (size_t i = 1; i < chunks.size(); i += 2)
+				data_kept = data_kept && *chunks[i] == AllocatorTestClass(i * 0.5, static_cast<int>(i));
+
+			for (size_t i = 1; i < chunks.size(); i += 2)
+				sfla.Free(chunks[i]);
+
+			std::list<SegregatedFreeListAllocator::SegregatedFreeHeader*> free_chunks = sfla.GetFreeChunks();
+
+			return data_kept && free_chunks.size() == 1 && free_chunks.front()->m_chunk_size == sfla.GetBufferSize() - sizeof(SegregatedFreeListAllocator::FreeListAllocHeader);
+		}
+	}
+}
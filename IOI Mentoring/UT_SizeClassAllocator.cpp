@@ -0,0 +1,148 @@
+/***************************************************************************//**
+ * @filename UT_SizeClassAllocator.cpp
+ * @brief	 Contains the size class small object allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "SizeClassAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool sizeclass_init()
+		{
+			SizeClassAllocator sca;
+			std::vector<std::byte> buffer(10 * 4096 + 100);
+			sca.Init(buffer);
+
+			return sca.GetBufferSize() == 10 * 4096 + 100 && sca.GetRegionSize() == 4096 && sca.GetFreeChunkAmount(0) == 512 &&
+				   sca.GetFreeChunkAmount(SizeClassAllocator::SIZE_CLASS_COUNT - 1) == 1;
+		}
+
+		bool sizeclass_lookup()
+		{
+			// Every size goes to the smallest class it fits in
+			bool classes_fit = true;
+			for (unsigned size = 1u; size <= SizeClassAllocator::MAX_SIZE_CLASS; size++)
+			{
+				const unsigned size_class = SizeClassAllocator::GetSizeClass(size);
+				classes_fit = classes_fit && SizeClassAllocator::GetSizeClassSize(size_class) >= size &&
+							  (size_class == 0u || SizeClassAllocator::GetSizeClassSize(size_class - 1u) < size);
+			}
+
+			return classes_fit && SizeClassAllocator::GetSizeClass(8) == 0 && SizeClassAllocator::GetSizeClass(9) == 1 &&
+				   SizeClassAllocator::GetSizeClass(4096) == 9 && SizeClassAllocator::GetSizeClass(4097) == SizeClassAllocator::SIZE_CLASS_COUNT;
+		}
+
+		bool sizeclass_allocate_0()
+		{
+			SizeClassAllocator sca;
+			std::vector<std::byte> buffer(10 * 4096);
+			sca.Init(buffer);
+
+			// Each size lands in the region of its class
+			void* chunk_0 = sca.Allocate(5);
+			void* chunk_1 = sca.Allocate(100);
+			void* chunk_2 = sca.Allocate(4096);
+
+			void* chunk_3 = sca.Allocate(0);
+			void* chunk_4 = sca.Allocate(5000);
+
+			return chunk_0 == buffer.data() && chunk_1 == buffer.data() + 4 * 4096 && chunk_2 == buffer.data() + 9 * 4096 &&
+				   chunk_3 == nullptr && chunk_4 == nullptr && sca.GetAllocationSize(chunk_1) == 128;
+		}
+
+		bool sizeclass_allocate_1()
+		{
+			SizeClassAllocator sca;
+			std::vector<std::byte> buffer(10 * 4096);
+			sca.Init(buffer);
+
+			// The 2048 class has 2 chunks, the third one comes from the 4096 class and then there is no room left
+			void* chunk_0 = sca.Allocate(2000);
+			void* chunk_1 = sca.Allocate(2000);
+			void* chunk_2 = sca.Allocate(2000);
+			void* chunk_3 = sca.Allocate(2000);
+
+			return chunk_0 != nullptr && chunk_1 != nullptr && chunk_2 == buffer.data() + 9 * 4096 && chunk_3 == nullptr &&
+				   sca.GetAllocationSize(chunk_2) == 4096;
+		}
+
+		bool sizeclass_free_0()
+		{
+			SizeClassAllocator sca;
+			std::vector<std::byte> buffer(10 * 4096);
+			sca.Init(buffer);
+
+			void* chunk_0 = sca.Allocate(24);
+			void* chunk_1 = sca.Allocate(24);
+			sca.Free(chunk_0);
+
+			// Invalid ptrs and double frees are ignored
+			int* temp_ptr = new int;
+			sca.Free(static_cast<void*>(temp_ptr));
+			delete temp_ptr;
+			sca.Free(static_cast<std::byte*>(chunk_1) + 2);
+			sca.Free(chunk_0);
+
+			return sca.IsChunkFree(chunk_0) && !sca.IsChunkFree(chunk_1) && sca.GetFreeChunkAmount(2) == 127 && sca.Allocate(30) == chunk_0;
+		}
+
+		bool sizeclass_clear()
+		{
+			SizeClassAllocator sca;
+			std::vector<std::byte> buffer(10 * 4096);
+			sca.Init(buffer);
+
+			sca.Allocate(24);
+			sca.Allocate(1000);
+			sca.Clear();
+
+			return sca.GetFreeChunkAmount(2) == 128 && sca.GetFreeChunkAmount(7) == 4 && sca.Allocate(1000) == buffer.data() + 7 * 4096;
+		}
+
+		bool sizeclass_prod()
+		{
+			SizeClassAllocator sca;
+			std::vector<std::byte> buffer(1u << 20);
+			sca.Init(buffer);
+
+			std::vector<AllocatorTestClass*> chunks;
+			for (int i = 0; i < 2000; i++)
+			{
+				// Arrays of a few different sizes
+				const unsigned count = 1u + i % 7;
+				AllocatorTestClass* chunk = static_cast<AllocatorTestClass*>(sca.Allocate(sizeof(AllocatorTestClass) * count));
+				for (unsigned j = 0u; j < count; j++)
+					new (chunk + j) AllocatorTestClass(i * 0.5, i);
+				chunks.push_back(chunk);
+
+				if (i % 3 == 2)
+				{
+					sca.Free(chunks[chunks.size() - 2]);
+					chunks.erase(chunks.end() - 2);
+				}
+			}
+
+			bool data_kept = true;
+			for (AllocatorTestClass* chunk : chunks)
+			{
+				const int i = chunk->x;
+				for (unsigned j = 0u; j < 1u + i % 7; j++)
+					data_kept = data_kept && chunk[j] == AllocatorTestClass(i * 0.5, i);
+				sca.Free(chunk);
+			}
+
+			bool all_free = true;
+			for (unsigned i = 0u; i < SizeClassAllocator::SIZE_CLASS_COUNT; i++)
+				all_free = all_free && sca.GetFreeChunkAmount(i) == sca.GetRegionSize() / SizeClassAllocator::GetSizeClassSize(i);
+
+			return data_kept && all_free;
+		}
+	}
+}
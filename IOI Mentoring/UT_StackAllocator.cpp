@@ -7,6 +7,7 @@
 #include "pch.h"
 #include "UnitTests.h"
 #include "StackAllocator.h"
+#include "ScopedArena.h"
 #include "AllocatorTestClass.h"
 
 namespace UT
@@ -25,24 +26,44 @@ namespace UT
         bool stack_allocate_0()
         {
             StackAllocator sa;
-            std::byte buffer[48];
+            alignas(8) std::byte buffer[48];
             sa.Init(buffer);
 
             sa.Allocate(20, 4);
 
-            return sa.GetOffset() == 20 + sizeof(StackAllocator::StackAllocationFooter) + (20 % 4);
+            return sa.GetOffset() == 20 + sizeof(StackAllocator::StackAllocationFooter);
         }
 
         bool stack_allocate_1()
         {
             StackAllocator sa;
-            std::byte buffer[48];
+            alignas(8) std::byte buffer[48];
             sa.Init(buffer);
 
             sa.Allocate(20, 8);
             sa.Allocate(30);
 
-            return sa.GetOffset() == 20 + sizeof(StackAllocator::StackAllocationFooter) + (20 % 8);
+            return sa.GetOffset() == 20 + sizeof(StackAllocator::StackAllocationFooter);
+        }
+
+        bool stack_align()
+        {
+            StackAllocator sa;
+            alignas(64) std::byte buffer[256];
+            sa.Init(buffer);
+
+            // The padding goes in front of the block and is popped with it
+            sa.AllocateWithoutFooter(1);
+            std::byte* data_0 = static_cast<std::byte*>(sa.Allocate(8, 32));
+            const size_t offset = sa.GetOffset();
+            std::byte* data_1 = static_cast<std::byte*>(sa.Allocate<64>(8));
+            std::byte* data_2 = static_cast<std::byte*>(sa.AllocateWithoutFooter<16>(8));
+            const bool aligned = data_0 == &buffer[32] && data_1 == &buffer[64] && data_2 == &buffer[80] && sa.Allocate(8, 24) == nullptr;
+
+            sa.FreeToMarker(80);
+            sa.Free();
+
+            return aligned && sa.GetOffset() == offset;
         }
 
         bool stack_free_0()
@@ -69,6 +90,128 @@ namespace UT
             return sa.GetBufferSize() == 48;
         }
 
+        bool stack_free_2()
+        {
+            StackAllocator sa;
+            std::byte buffer[48];
+            sa.Init(buffer);
+
+            // Less than a footer left, nothing to pop
+            sa.AllocateWithoutFooter(4);
+            sa.Free();
+
+            return sa.GetOffset() == 4u;
+        }
+
+        bool stack_marker_0()
+        {
+            StackAllocator sa;
+            std::byte buffer[128];
+            sa.Init(buffer);
+
+            sa.Allocate(8);
+            const StackAllocator::Marker marker = sa.GetMarker();
+            sa.Allocate(8);
+            sa.Allocate(16);
+
+            // Both allocations are popped without reading their footers, a marker past the offset is ignored
+            sa.FreeToMarker(marker);
+            sa.FreeToMarker(100);
+            const bool rewound = sa.GetOffset() == marker;
+
+            // Footers below the marker are still there
+            sa.Free();
+
+            return rewound && marker == 8 + sizeof(StackAllocator::StackAllocationFooter) && sa.GetOffset() == 0u;
+        }
+
+        bool stack_marker_1()
+        {
+            StackAllocator sa;
+            std::byte buffer[64];
+            sa.Init(buffer);
+
+            // No footers, the allocations are packed
+            const StackAllocator::Marker marker = sa.GetMarker();
+            std::byte* data_0 = static_cast<std::byte*>(sa.AllocateWithoutFooter(8));
+            std::byte* data_1 = static_cast<std::byte*>(sa.AllocateWithoutFooter(8));
+            const bool packed = data_0 == &buffer[0] && data_1 == &buffer[8] && sa.GetOffset() == 16u;
+
+            sa.FreeToMarker(marker);
+
+            return packed && sa.GetOffset() == 0u && sa.AllocateWithoutFooter(65) == nullptr && sa.AllocateWithoutFooter(0) == nullptr;
+        }
+
+        bool stack_scoped()
+        {
+            StackAllocator sa;
+            std::byte buffer[128];
+            sa.Init(buffer);
+
+            sa.Allocate(8);
+            const size_t base_offset = sa.GetOffset();
+            bool nested_rewound = false;
+            {
+                ScopedArena<StackAllocator> outer(sa);
+                outer.Allocate(8);
+                const size_t outer_offset = sa.GetOffset();
+                {
+                    ScopedArena<StackAllocator> inner(sa);
+                    for (int i = 0; i < 4; i++)
+                        sa.AllocateWithoutFooter(8);
+                }
+                nested_rewound = sa.GetOffset() == outer_offset;
+            }
+
+            return nested_rewound && sa.GetOffset() == base_offset;
+        }
+
+        bool stack_double_ended_0()
+        {
+            StackAllocator sa;
+            alignas(8) std::byte buffer[64];
+            sa.Init(buffer);
+
+            // The top end grows down from the end of the buffer, the footer goes below the block
+            std::byte* bottom = static_cast<std::byte*>(sa.Allocate(16));
+            std::byte* top_0 = static_cast<std::byte*>(sa.AllocateTop(8));
+            std::byte* top_1 = static_cast<std::byte*>(sa.AllocateTopWithoutFooter(8));
+            const bool placed = bottom == &buffer[0] && top_0 == &buffer[56] && top_1 == &buffer[40] && sa.GetTopOffset() == 24;
+
+            // Both ends share what is left, 16 bytes
+            const bool full = sa.Allocate(16) == nullptr && sa.AllocateTop(16) == nullptr && sa.AllocateWithoutFooter(16) != nullptr &&
+                              sa.AllocateTopWithoutFooter(1) == nullptr;
+
+            sa.Clear();
+
+            return placed && full && sa.GetOffset() == 0u && sa.GetTopOffset() == 0u;
+        }
+
+        bool stack_double_ended_1()
+        {
+            StackAllocator sa;
+            alignas(64) std::byte buffer[256];
+            sa.Init(buffer);
+
+            sa.Allocate(24);
+            const StackAllocator::Marker marker = sa.GetTopMarker();
+
+            // The top block is aligned down, the gap above it is popped with it
+            sa.AllocateTop(8);
+            std::byte* top = static_cast<std::byte*>(sa.AllocateTop(4, 64));
+            const size_t top_offset = sa.GetTopOffset();
+            sa.AllocateTop(16);
+            sa.FreeTop();
+            const bool popped = top == &buffer[192] && sa.GetTopOffset() == top_offset;
+
+            // Each end rewinds on its own
+            sa.FreeToTopMarker(marker);
+            sa.FreeToTopMarker(512);
+            sa.FreeTop();
+
+            return popped && sa.GetTopOffset() == 0u && sa.GetOffset() == 24 + sizeof(StackAllocator::StackAllocationFooter);
+        }
+
         bool stack_clear()
         {
             StackAllocator sa;
@@ -83,7 +226,7 @@ namespace UT
         bool stack_prod()
         {
             StackAllocator sa;
-            std::byte buffer_0[sizeof(AllocatorTestClass) * 8];
+            alignas(AllocatorTestClass) std::byte buffer_0[sizeof(AllocatorTestClass) * 8];
             sa.Init(buffer_0);
 
             AllocatorTestClass* data_0 = new (sa.Allocate(sizeof(AllocatorTestClass), 4)) AllocatorTestClass(1.2, 8);
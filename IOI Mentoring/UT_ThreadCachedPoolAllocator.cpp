@@ -0,0 +1,228 @@
+/***************************************************************************//**
+ * @filename UT_ThreadCachedPoolAllocator.cpp
+ * @brief	 Contains the thread cached pool allocator unit test function
+ *			 implementations.
+ * @author   Inaki Arostegui
+ ******************************************************************************/
+
+#include "pch.h"
+#include "UnitTests.h"
+#include "ThreadCachedPoolAllocator.h"
+#include "AllocatorTestClass.h"
+
+namespace UT
+{
+	namespace Allocator
+	{
+		bool threadcachedpool_init()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[512];
+			tcpa.Init(buffer, 16, 8);
+
+			return tcpa.GetBufferSize() == 512 && tcpa.GetChunkSize() == 16 && tcpa.GetMagazineSize() == 8 && tcpa.GetFreeChunkAmount() == 32;
+		}
+
+		bool threadcachedpool_allocate_0()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[512];
+			tcpa.Init(buffer, 16, 8);
+
+			// An empty magazine takes half a magazine from the pool, in the order the pool gives them out
+			void* chunk_0 = tcpa.Allocate();
+			bool batch_taken = tcpa.GetFreeChunkAmount() == 28;
+
+			void* chunk_1 = tcpa.Allocate();
+
+			tcpa.FlushThreadCache();
+
+			return chunk_0 == buffer && chunk_1 == buffer + 16 && batch_taken && tcpa.GetFreeChunkAmount() == 30;
+		}
+
+		bool threadcachedpool_allocate_1()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[96];
+			tcpa.Init(buffer, 16, 8);
+
+			// The last refill gets what the pool has left
+			std::vector<void*> chunks;
+			for (int i = 0; i < 6; i++)
+				chunks.push_back(tcpa.Allocate());
+
+			void* chunk_6 = tcpa.Allocate();
+
+			for (void* chunk : chunks)
+				tcpa.Free(chunk);
+			tcpa.FlushThreadCache();
+
+			return std::find(chunks.begin(), chunks.end(), nullptr) == chunks.end() && chunk_6 == nullptr && tcpa.GetFreeChunkAmount() == 6;
+		}
+
+		bool threadcachedpool_free_0()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[512];
+			tcpa.Init(buffer, 16, 8);
+
+			std::vector<void*> chunks;
+			for (int i = 0; i < 20; i++)
+				chunks.push_back(tcpa.Allocate());
+
+			// Freed chunks stay in the magazine until it is full, then half of it goes back
+			for (int i = 0; i < 8; i++)
+				tcpa.Free(chunks[i]);
+			bool kept = tcpa.GetFreeChunkAmount() == 12;
+
+			tcpa.Free(chunks[8]);
+			bool flushed = tcpa.GetFreeChunkAmount() == 16;
+
+			// Invalid ptrs are ignored
+			int* temp_ptr = new int;
+			tcpa.Free(static_cast<void*>(temp_ptr));
+			delete temp_ptr;
+			tcpa.Free(static_cast<std::byte*>(chunks[9]) + 2);
+
+			// The last freed chunk is the first one to be allocated again
+			bool reused = tcpa.Allocate() == chunks[8];
+
+			for (int i = 9; i < 20; i++)
+				tcpa.Free(chunks[i]);
+			tcpa.FlushThreadCache();
+
+			return kept && flushed && reused && tcpa.GetFreeChunkAmount() == 31;
+		}
+
+		bool threadcachedpool_free_1()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[512];
+			tcpa.Init(buffer, 16, 8);
+
+			// The magazine of a thread is flushed when it exits, even if it didnt flush it
+			std::vector<void*> chunks;
+			std::thread allocating_thread([&tcpa, &chunks]()
+				{
+					for (int i = 0; i < 10; i++)
+						chunks.push_back(tcpa.Allocate());
+
+					tcpa.Free(chunks.back());
+					chunks.pop_back();
+				});
+			allocating_thread.join();
+
+			bool exit_flushed = tcpa.GetFreeChunkAmount() == 23;
+
+			// Allocated in another thread, freed in this one
+			for (void* chunk : chunks)
+				tcpa.Free(chunk);
+			tcpa.FlushThreadCache();
+
+			return exit_flushed && tcpa.GetFreeChunkAmount() == 32;
+		}
+
+		bool threadcachedpool_free_2()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[256];
+			tcpa.Init(buffer, 16, 8);
+
+			// Freed twice while it sits in the magazine
+			void* chunk_0 = tcpa.Allocate();
+			tcpa.Free(chunk_0);
+			tcpa.Free(chunk_0);
+			void* chunk_1 = tcpa.Allocate();
+			void* chunk_2 = tcpa.Allocate();
+			const bool magazine_freed_once = chunk_1 == chunk_0 && chunk_2 != chunk_0;
+
+			// Freed again after the flush gave it back to the pool
+			tcpa.Free(chunk_1);
+			tcpa.Free(chunk_2);
+			tcpa.FlushThreadCache();
+			tcpa.Free(chunk_1);
+
+			// Every chunk is handed out once
+			std::vector<void*> chunks;
+			for (int i = 0; i < 16; i++)
+				chunks.push_back(tcpa.Allocate());
+
+			void* chunk_3 = tcpa.Allocate();
+
+			std::vector<void*> sorted_chunks = chunks;
+			std::sort(sorted_chunks.begin(), sorted_chunks.end());
+			const bool pool_freed_once = std::adjacent_find(sorted_chunks.begin(), sorted_chunks.end()) == sorted_chunks.end() &&
+										 std::find(chunks.begin(), chunks.end(), nullptr) == chunks.end() && chunk_3 == nullptr;
+
+			for (void* chunk : chunks)
+				tcpa.Free(chunk);
+			tcpa.FlushThreadCache();
+
+			return magazine_freed_once && pool_freed_once && tcpa.GetFreeChunkAmount() == 16;
+		}
+
+		bool threadcachedpool_clear()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::byte buffer[512];
+			tcpa.Init(buffer, 16, 8);
+
+			tcpa.Allocate();
+			tcpa.Allocate();
+			tcpa.Clear();
+
+			// The magazine is empty after clearing, so it takes a new batch
+			bool cleared = tcpa.GetFreeChunkAmount() == 32;
+			void* chunk_0 = tcpa.Allocate();
+			bool batch_taken = tcpa.GetFreeChunkAmount() == 28;
+
+			tcpa.Free(chunk_0);
+			tcpa.FlushThreadCache();
+
+			return cleared && chunk_0 == buffer && batch_taken && tcpa.GetFreeChunkAmount() == 32;
+		}
+
+		bool threadcachedpool_prod()
+		{
+			ThreadCachedPoolAllocator tcpa;
+			std::vector<std::byte> buffer(sizeof(AllocatorTestClass) * 512);
+			tcpa.Init(buffer, sizeof(AllocatorTestClass), 16);
+
+			// Every thread can hold up to 32 chunks and 16 in its magazine, the pool is just big enough. Threads dont flush, they exit.
+			std::atomic<bool> data_kept = true;
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 8; t++)
+			{
+				threads.emplace_back([&tcpa, &data_kept, t]()
+					{
+						std::vector<AllocatorTestClass*> chunks;
+						for (int i = 0; i < 20000; i++)
+						{
+							if (chunks.size() < 32 && i % 4 != 3)
+							{
+								if (void* chunk = tcpa.Allocate())
+									chunks.push_back(new (chunk) AllocatorTestClass(i * 0.5, t));
+							}
+							else if (!chunks.empty())
+							{
+								data_kept = data_kept && chunks.back()->x == t;
+								tcpa.Free(chunks.back());
+								chunks.pop_back();
+							}
+						}
+
+						for (AllocatorTestClass* chunk : chunks)
+						{
+							data_kept = data_kept && chunk->x == t;
+							tcpa.Free(chunk);
+						}
+					});
+			}
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			return data_kept && tcpa.GetFreeChunkAmount() == 512;
+		}
+	}
+}
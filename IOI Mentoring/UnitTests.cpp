@@ -11,7 +11,8 @@
 const std::string PASS = "PASS";
 const std::string FAIL = ">>>>>>>>>>>>>>>>>>>>>>>>> FAIL <<<<<<<<<<<<<<<<<<<<<<<<";
 
-const std::array<std::string, 6> UT_TITLES = { "VECTORS", "MOVE SEMANTICS", "LINEAR ALLOCATOR", "STACK ALLOCATOR", "POOL ALLOCATOR", "FREE LIST ALLOCATOR", };
+const std::array<std::string, 15> UT_TITLES = { "VECTORS", "MOVE SEMANTICS", "LINEAR ALLOCATOR", "FRAME ARENA", "CHAINED LINEAR ALLOCATOR", "STACK ALLOCATOR", "POOL ALLOCATOR", "CONCURRENT POOL ALLOCATOR", "THREAD CACHED POOL ALLOCATOR",
+                                               "GROWABLE POOL ALLOCATOR", "SIZE CLASS ALLOCATOR", "OBJECT POOL", "FREE LIST ALLOCATOR", "SEGREGATED FREE LIST ALLOCATOR", "CONCURRENT FREE LIST ALLOCATOR", };
 
 using namespace UT;
 using namespace MoveSemantics;
@@ -71,11 +72,43 @@ std::unordered_map<e_UTTypes, std::vector<UnitTest>> unit_tests =
             UnitTest{"INIT",         &linear_init        },
             UnitTest{"ALLOCATE 0",   &linear_allocate_0  },
             UnitTest{"ALLOCATE 1",   &linear_allocate_1  },
+            UnitTest{"ALIGN 0",      &linear_align_0     },
+            UnitTest{"ALIGN 1",      &linear_align_1     },
             UnitTest{"FREE 0",       &linear_free_0      },
+            UnitTest{"MARKER",       &linear_marker      },
+            UnitTest{"SCOPED",       &linear_scoped      },
             UnitTest{"PRODUCTION",   &linear_prod        },
         }
     ),
     std::make_pair
+    (
+        e_UTTypes::e_alloc_framearena,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",         &framearena_init        },
+            UnitTest{"FREE 0",       &framearena_free_0      },
+            UnitTest{"FREE 1",       &framearena_free_1      },
+            UnitTest{"BUFFERED 0",   &framearena_buffered_0  },
+            UnitTest{"BUFFERED 1",   &framearena_buffered_1  },
+            UnitTest{"BUFFERED 2",   &framearena_buffered_2  },
+            UnitTest{"CLEAR",        &framearena_clear       },
+            UnitTest{"PRODUCTION",   &framearena_prod        },
+        }
+    ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_chainedlinear,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",         &chainedlinear_init        },
+            UnitTest{"ALLOCATE 0",   &chainedlinear_allocate_0  },
+            UnitTest{"ALLOCATE 1",   &chainedlinear_allocate_1  },
+            UnitTest{"ALLOCATE 2",   &chainedlinear_allocate_2  },
+            UnitTest{"CLEAR",        &chainedlinear_clear       },
+            UnitTest{"PRODUCTION",   &chainedlinear_prod        },
+        }
+    ),
+    std::make_pair
     (
         e_UTTypes::e_alloc_stack,
         std::vector<UnitTest>
@@ -83,8 +116,15 @@ std::unordered_map<e_UTTypes, std::vector<UnitTest>> unit_tests =
             UnitTest{"INIT",          &stack_init         },
             UnitTest{"ALLOCATE 0",    &stack_allocate_0   },
             UnitTest{"ALLOCATE 1",    &stack_allocate_1   },
+            UnitTest{"ALIGN",         &stack_align        },
             UnitTest{"FREE 0",        &stack_free_0       },
             UnitTest{"FREE 1",        &stack_free_1       },
+            UnitTest{"FREE 2",        &stack_free_2       },
+            UnitTest{"MARKER 0",      &stack_marker_0     },
+            UnitTest{"MARKER 1",      &stack_marker_1     },
+            UnitTest{"SCOPED",        &stack_scoped       },
+            UnitTest{"DOUBLE ENDED 0", &stack_double_ended_0 },
+            UnitTest{"DOUBLE ENDED 1", &stack_double_ended_1 },
             UnitTest{"CLEAR",         &stack_clear        },
             UnitTest{"PRODUCTION",    &stack_prod         },
         }
@@ -100,11 +140,91 @@ std::unordered_map<e_UTTypes, std::vector<UnitTest>> unit_tests =
             UnitTest{"FREE 0",         &pool_free_0         },
             UnitTest{"FREE 1",         &pool_free_1         },
             UnitTest{"FREE 1",         &pool_free_2         },
+            UnitTest{"FREE 3",         &pool_free_3         },
+            UnitTest{"BATCH 0",        &pool_batch_0        },
+            UnitTest{"BATCH 1",        &pool_batch_1        },
+            UnitTest{"TINY 0",         &pool_tiny_0         },
+            UnitTest{"TINY 1",         &pool_tiny_1         },
+            UnitTest{"RELOCATE",       &pool_relocate       },
+            UnitTest{"OPEN",           &pool_open           },
+            UnitTest{"ALIGN 0",        &pool_align_0        },
+            UnitTest{"ALIGN 1",        &pool_align_1        },
             UnitTest{"CLEAR",          &pool_clear          },
+            UnitTest{"CLEAR LAZY",     &pool_clear_lazy     },
             UnitTest{"PRODUCTION",     &pool_prod           },
         }
     ),
     std::make_pair
+    (
+        e_UTTypes::e_alloc_concurrentpool,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",           &concurrentpool_init         },
+            UnitTest{"ALLOCATE 0",     &concurrentpool_allocate_0   },
+            UnitTest{"FREE 0",         &concurrentpool_free_0       },
+            UnitTest{"BATCH",          &concurrentpool_batch        },
+            UnitTest{"CLEAR",          &concurrentpool_clear        },
+            UnitTest{"PRODUCTION",     &concurrentpool_prod         },
+            UnitTest{"PRODUCTION BATCH", &concurrentpool_prod_batch },
+        }
+    ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_threadcachedpool,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",           &threadcachedpool_init       },
+            UnitTest{"ALLOCATE 0",     &threadcachedpool_allocate_0 },
+            UnitTest{"ALLOCATE 1",     &threadcachedpool_allocate_1 },
+            UnitTest{"FREE 0",         &threadcachedpool_free_0     },
+            UnitTest{"FREE 1",         &threadcachedpool_free_1     },
+            UnitTest{"FREE 2",         &threadcachedpool_free_2     },
+            UnitTest{"CLEAR",          &threadcachedpool_clear      },
+            UnitTest{"PRODUCTION",     &threadcachedpool_prod       },
+        }
+    ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_growablepool,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",           &growablepool_init           },
+            UnitTest{"ALLOCATE 0",     &growablepool_allocate_0     },
+            UnitTest{"ALLOCATE 1",     &growablepool_allocate_1     },
+            UnitTest{"FREE 0",         &growablepool_free_0         },
+            UnitTest{"FREE 1",         &growablepool_free_1         },
+            UnitTest{"CLEAR",          &growablepool_clear          },
+            UnitTest{"PRODUCTION",     &growablepool_prod           },
+        }
+    ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_sizeclass,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",           &sizeclass_init              },
+            UnitTest{"LOOKUP",         &sizeclass_lookup            },
+            UnitTest{"ALLOCATE 0",     &sizeclass_allocate_0        },
+            UnitTest{"ALLOCATE 1",     &sizeclass_allocate_1        },
+            UnitTest{"FREE 0",         &sizeclass_free_0            },
+            UnitTest{"CLEAR",          &sizeclass_clear             },
+            UnitTest{"PRODUCTION",     &sizeclass_prod              },
+        }
+    ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_objectpool,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",           &objectpool_init             },
+            UnitTest{"CREATE",         &objectpool_create           },
+            UnitTest{"DESTROY",        &objectpool_destroy          },
+            UnitTest{"GENERATION",     &objectpool_generation       },
+            UnitTest{"FOR EACH",       &objectpool_foreach          },
+            UnitTest{"CLEAR",          &objectpool_clear            },
+        }
+    ),
+    std::make_pair
     (
         e_UTTypes::e_alloc_freelist,
         std::vector<UnitTest>
@@ -117,13 +237,56 @@ std::unordered_map<e_UTTypes, std::vector<UnitTest>> unit_tests =
             UnitTest{"ALLOCATE BEST FIT 0",     &freelist_allocate_bestfit_0    },
             UnitTest{"ALLOCATE BEST FIT 1",     &freelist_allocate_bestfit_1    },
             UnitTest{"ALLOCATE BEST FIT 2",     &freelist_allocate_bestfit_2    },
+            UnitTest{"ALLOCATE BEST FIT 3",     &freelist_allocate_bestfit_3    },
+            UnitTest{"ALLOCATE NEXT FIT 0",     &freelist_allocate_nextfit_0    },
+            UnitTest{"ALLOCATE ALIGNED 0",      &freelist_allocate_aligned_0    },
+            UnitTest{"ALLOCATE ALIGNED 1",      &freelist_allocate_aligned_1    },
+            UnitTest{"REALLOCATE 0",            &freelist_reallocate_0          },
+            UnitTest{"REALLOCATE 1",            &freelist_reallocate_1          },
             UnitTest{"FREE 0",                  &freelist_free_0				},
             UnitTest{"FREE 1",                  &freelist_free_1				},
             UnitTest{"FREE 2",                  &freelist_free_2			    },
+            UnitTest{"FREE 3",                  &freelist_free_3                },
+            UnitTest{"FREE 4",                  &freelist_free_4                },
             UnitTest{"CLEAR",                   &freelist_clear                 },
+            UnitTest{"STATS",                   &freelist_stats                 },
+            UnitTest{"GRANULARITY",             &freelist_granularity           },
+            UnitTest{"POLICY",                  &freelist_policy                },
             UnitTest{"PRODUCTION",              &freelist_prod                  },
         }
     ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_segfreelist,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",                    &segfreelist_init               },
+            UnitTest{"ALLOCATE 0",              &segfreelist_allocate_0         },
+            UnitTest{"ALLOCATE 1",              &segfreelist_allocate_1         },
+            UnitTest{"ALLOCATE 2",              &segfreelist_allocate_2         },
+            UnitTest{"FREE 0",                  &segfreelist_free_0             },
+            UnitTest{"FREE 1",                  &segfreelist_free_1             },
+            UnitTest{"FREE 2",                  &segfreelist_free_2             },
+            UnitTest{"CLEAR",                   &segfreelist_clear              },
+            UnitTest{"PRODUCTION",              &segfreelist_prod               },
+        }
+    ),
+    std::make_pair
+    (
+        e_UTTypes::e_alloc_concurrentfreelist,
+        std::vector<UnitTest>
+        {
+            UnitTest{"INIT",                    &concurrentfreelist_init        },
+            UnitTest{"ALLOCATE 0",              &concurrentfreelist_allocate_0  },
+            UnitTest{"ALLOCATE 1",              &concurrentfreelist_allocate_1  },
+            UnitTest{"FREE 0",                  &concurrentfreelist_free_0      },
+            UnitTest{"FREE 1",                  &concurrentfreelist_free_1      },
+            UnitTest{"FREE 2",                  &concurrentfreelist_free_2      },
+            UnitTest{"FREE 3",                  &concurrentfreelist_free_3      },
+            UnitTest{"CLEAR",                   &concurrentfreelist_clear       },
+            UnitTest{"PRODUCTION",              &concurrentfreelist_prod        },
+        }
+    ),
 };
 
 void UT::RunUnitTests(std::vector<UT::e_UTTypes>&& test_types_to_run)
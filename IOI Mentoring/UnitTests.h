@@ -11,7 +11,7 @@
 
 namespace UT
 {
-	enum class e_UTTypes { e_vectors, e_move_semantics, e_alloc_linear, e_alloc_stack, e_alloc_pool, e_alloc_freelist };
+	enum class e_UTTypes { e_vectors, e_move_semantics, e_alloc_linear, e_alloc_framearena, e_alloc_chainedlinear, e_alloc_stack, e_alloc_pool, e_alloc_concurrentpool, e_alloc_threadcachedpool, e_alloc_growablepool, e_alloc_sizeclass, e_alloc_objectpool, e_alloc_freelist, e_alloc_segfreelist, e_alloc_concurrentfreelist };
 
 	namespace MoveSemantics
 	{
@@ -35,14 +35,41 @@ namespace UT
 		bool linear_init();
 		bool linear_allocate_0();				// Basic allocation
 		bool linear_allocate_1();				// Invalid ptr allocation
+		bool linear_align_0();					// Runtime power of two alignment
+		bool linear_align_1();					// Compile time alignment
 		bool linear_free_0();					// Basic free
+		bool linear_marker();					// Rewinding to a marker, invalid marker
+		bool linear_scoped();					// Nested scoped arenas
 		bool linear_prod();
 
+		bool framearena_init();
+		bool framearena_free_0();				// Rewinding when the last allocation is freed
+		bool framearena_free_1();				// Invalid ptrs and more frees than allocations
+		bool framearena_buffered_0();			// Frame rotation
+		bool framearena_buffered_1();			// Invalid frame counts, freeing from a previous frame
+		bool framearena_buffered_2();			// Stale free from a recycled frame and double free
+		bool framearena_clear();
+		bool framearena_prod();					// Per request allocation and free
+
+		bool chainedlinear_init();
+		bool chainedlinear_allocate_0();		// Basic and aligned allocation
+		bool chainedlinear_allocate_1();		// Geometric block growth, allocations larger than a block
+		bool chainedlinear_allocate_2();		// Upstream source running out
+		bool chainedlinear_clear();				// Keeping the largest block
+		bool chainedlinear_prod();				// Request sizes varying by 64x
+
 		bool stack_init();
 		bool stack_allocate_0();				// Basic allocation
 		bool stack_allocate_1();				// Invalid ptr allocation
+		bool stack_align();						// Runtime and compile time alignment, popping the padding
 		bool stack_free_0();					// Basic free
 		bool stack_free_1();					// Empty free
+		bool stack_free_2();					// Free with less than a footer allocated
+		bool stack_marker_0();					// Rewinding to a marker, invalid marker
+		bool stack_marker_1();					// Allocations without footer
+		bool stack_scoped();					// Nested scoped arenas
+		bool stack_double_ended_0();			// Allocating from both ends
+		bool stack_double_ended_1();			// Top end alignment, free and markers
 		bool stack_clear();
 		bool stack_prod();
 
@@ -52,9 +79,59 @@ namespace UT
 		bool pool_free_0();						// Basic free
 		bool pool_free_1();						// Invalid ptr free
 		bool pool_free_2();						// Invalid ptr free
+		bool pool_free_3();						// Double free
+		bool pool_batch_0();					// AllocateN from the free list and the never used chunks
+		bool pool_batch_1();					// FreeN with invalid ptrs and duplicates
+		bool pool_tiny_0();						// 16-bit links, chunks smaller than a ptr
+		bool pool_tiny_1();						// 32-bit links past 65535 chunks
+		bool pool_relocate();					// Pool copied to another buffer
+		bool pool_open();						// Pool rebuilt from a copy of a buffer with its header
+		bool pool_align_0();					// Chunk alignment
+		bool pool_align_1();					// Isolated chunks on their own cache lines
 		bool pool_clear();
+		bool pool_clear_lazy();					// Chunks are carved on first use, Init & Clear dont write to them
 		bool pool_prod();
 
+		bool concurrentpool_init();
+		bool concurrentpool_allocate_0();		// Basic allocation and running out of chunks
+		bool concurrentpool_free_0();			// Basic free, invalid ptr and double free
+		bool concurrentpool_batch();			// AllocateN & FreeN
+		bool concurrentpool_clear();
+		bool concurrentpool_prod();				// Multithreaded allocation and free
+		bool concurrentpool_prod_batch();		// Multithreaded batch allocation and free
+
+		bool threadcachedpool_init();
+		bool threadcachedpool_allocate_0();		// Magazine refill from the pool
+		bool threadcachedpool_allocate_1();		// Running out of chunks
+		bool threadcachedpool_free_0();			// Magazine flush to the pool, invalid ptrs
+		bool threadcachedpool_free_1();			// Flush on thread exit, freeing chunks of another thread
+		bool threadcachedpool_free_2();			// Double free, in the magazine and after a flush
+		bool threadcachedpool_clear();
+		bool threadcachedpool_prod();			// Multithreaded allocation and free
+
+		bool growablepool_init();
+		bool growablepool_allocate_0();			// Growing by a slab
+		bool growablepool_allocate_1();			// Slabs from another allocator until it runs out
+		bool growablepool_free_0();				// Free slabs given back past the threshold
+		bool growablepool_free_1();				// Invalid ptr and double free
+		bool growablepool_clear();
+		bool growablepool_prod();
+
+		bool sizeclass_init();
+		bool sizeclass_lookup();				// Size to size class table
+		bool sizeclass_allocate_0();			// Basic allocation, sizes out of range
+		bool sizeclass_allocate_1();			// Full class moves up to the next one
+		bool sizeclass_free_0();				// Basic free, invalid ptr and double free
+		bool sizeclass_clear();
+		bool sizeclass_prod();
+
+		bool objectpool_init();					// Chunk size and alignment from the type
+		bool objectpool_create();
+		bool objectpool_destroy();				// Stale handles
+		bool objectpool_generation();			// Generation wrap around
+		bool objectpool_foreach();				// Iterating live objects
+		bool objectpool_clear();
+
 		bool freelist_init();
 		bool freelist_allocate_firstfit_0();	// Basic allocation 
 		bool freelist_allocate_firstfit_1();	// Buffer filling allocation
@@ -63,11 +140,42 @@ namespace UT
 		bool freelist_allocate_bestfit_0();		// Basic allocation
 		bool freelist_allocate_bestfit_1();		// Header fitting allocation
 		bool freelist_allocate_bestfit_2();		// Best fit allocation
+		bool freelist_allocate_bestfit_3();		// Best fit allocation after changing alloc type
+		bool freelist_allocate_nextfit_0();		// Next fit allocation
+		bool freelist_allocate_aligned_0();		// Aligned allocation giving back the leading padding
+		bool freelist_allocate_aligned_1();		// Aligned allocation keeping the padding
+		bool freelist_reallocate_0();			// In place reallocation (grow and shrink)
+		bool freelist_reallocate_1();			// Moving reallocation
 		bool freelist_free_0();					// Basic free (with list head and tail)
 		bool freelist_free_1();					// Invalid ptr free
 		bool freelist_free_2();					// Invalid ptr free
+		bool freelist_free_3();					// Double free
+		bool freelist_free_4();					// Payload bytes that look like an alloc header
 		bool freelist_clear();
+		bool freelist_stats();					// Stats after allocating, freeing, changing alloc type and clearing
+		bool freelist_granularity();			// Sizes and offsets stored in granules
+		bool freelist_policy();					// Compile time policies against the runtime alloc types
 		bool freelist_prod();					// Free chunk concatenation
+
+		bool segfreelist_init();
+		bool segfreelist_allocate_0();			// Basic allocation
+		bool segfreelist_allocate_1();			// Header fitting allocation
+		bool segfreelist_allocate_2();			// Segregated fit allocation
+		bool segfreelist_free_0();				// Free chunk concatenation (forward and backwards)
+		bool segfreelist_free_1();				// Invalid ptr and double free
+		bool segfreelist_free_2();				// Payload bytes that look like an alloc header
+		bool segfreelist_clear();
+		bool segfreelist_prod();
+
+		bool concurrentfreelist_init();
+		bool concurrentfreelist_allocate_0();	// Small (cached) and large allocation
+		bool concurrentfreelist_allocate_1();	// Aligned allocation
+		bool concurrentfreelist_free_0();		// Cached free and invalid ptr free
+		bool concurrentfreelist_free_1();		// Free from another thread
+		bool concurrentfreelist_free_2();		// Caches flushed and released on thread exit
+		bool concurrentfreelist_free_3();		// Double free, pending and cached
+		bool concurrentfreelist_clear();
+		bool concurrentfreelist_prod();			// Multithreaded allocation and free
 	}
 
 	namespace Vectors
@@ -91,8 +199,17 @@ namespace UT
 																		  e_UTTypes::e_vectors,
 																		  e_UTTypes::e_move_semantics,
 																		  e_UTTypes::e_alloc_linear,
+																		  e_UTTypes::e_alloc_framearena,
+																		  e_UTTypes::e_alloc_chainedlinear,
 																		  e_UTTypes::e_alloc_stack,
 																		  e_UTTypes::e_alloc_pool,
+																		  e_UTTypes::e_alloc_concurrentpool,
+																		  e_UTTypes::e_alloc_threadcachedpool,
+																		  e_UTTypes::e_alloc_growablepool,
+																		  e_UTTypes::e_alloc_sizeclass,
+																		  e_UTTypes::e_alloc_objectpool,
 																		  e_UTTypes::e_alloc_freelist,
+																		  e_UTTypes::e_alloc_segfreelist,
+																		  e_UTTypes::e_alloc_concurrentfreelist,
 																	   });
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include "pch.h"	
 #include "UnitTests.h"
+#include "Benchmarks.h"
 
 using namespace UT;
 
@@ -16,6 +17,8 @@ int main(void)
 	//UT::RunUnitTests({ e_UTTypes::e_move_semantics });
 	//UT::RunUnitTests({ e_UTTypes::e_alloc_linear, e_UTTypes::e_alloc_stack, e_UTTypes::e_alloc_pool, e_UTTypes::e_alloc_freelist});	
 
+	//BM::RunBenchmarks();
+
 	return 0; 
 }
 
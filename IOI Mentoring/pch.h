@@ -30,6 +30,13 @@
 #include <queue>
 #include <time.h>
 #include <optional>
+#include <bit>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
 
 // Windows API
 #define WIN32_LEAN_AND_MEAN